@@ -0,0 +1,149 @@
+#include "MicroBenchmark.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+namespace yosen::bench
+{
+    struct RegisteredBenchmark
+    {
+        std::string name;
+        benchmark_fn_t fn;
+    };
+
+    struct BenchmarkResult
+    {
+        std::string name;
+        uint64_t iterations = 0;
+        double ns_per_iteration = 0;
+        double items_per_second = 0;
+    };
+
+    static std::vector<RegisteredBenchmark>& get_registered_benchmarks()
+    {
+        static std::vector<RegisteredBenchmark> s_benchmarks;
+        return s_benchmarks;
+    }
+
+    bool register_benchmark(const std::string& name, benchmark_fn_t fn)
+    {
+        get_registered_benchmarks().push_back({ name, std::move(fn) });
+        return true;
+    }
+
+    static BenchmarkResult run_benchmark(const RegisteredBenchmark& benchmark, double min_time_ns)
+    {
+        constexpr uint64_t max_iterations = 1000000000;
+        uint64_t iterations = 1;
+
+        while (true)
+        {
+            BenchmarkState state(iterations);
+            benchmark.fn(state);
+
+            auto elapsed_ns = state.elapsed_ns();
+            if (elapsed_ns >= min_time_ns || iterations >= max_iterations)
+            {
+                BenchmarkResult result;
+                result.name = benchmark.name;
+                result.iterations = iterations;
+                result.ns_per_iteration = elapsed_ns / iterations;
+
+                if (state.items_processed() && elapsed_ns > 0)
+                    result.items_per_second = state.items_processed() * 1e9 / elapsed_ns;
+
+                return result;
+            }
+
+            // Aim slightly past the minimum time, growing at most tenfold per attempt
+            double multiplier = (elapsed_ns > 0) ? (min_time_ns * 1.4 / elapsed_ns) : 10.0;
+            multiplier = std::clamp(multiplier, 2.0, 10.0);
+
+            iterations = std::min(static_cast<uint64_t>(iterations * multiplier), max_iterations);
+        }
+    }
+
+    static void write_json(const std::string& path, const std::vector<BenchmarkResult>& results)
+    {
+        auto file = fopen(path.c_str(), "w");
+        if (!file)
+        {
+            fprintf(stderr, "Failed to write the results to \"%s\"\n", path.c_str());
+            return;
+        }
+
+        fprintf(file, "{\n  \"benchmarks\": [\n");
+
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            auto& result = results[i];
+
+            fprintf(file,
+                "    { \"name\": \"%s\", \"iterations\": %llu, \"ns_per_iteration\": %.3f, \"items_per_second\": %.1f }%s\n",
+                result.name.c_str(),
+                static_cast<unsigned long long>(result.iterations),
+                result.ns_per_iteration,
+                result.items_per_second,
+                (i + 1 < results.size()) ? "," : ""
+            );
+        }
+
+        fprintf(file, "  ]\n}\n");
+        fclose(file);
+    }
+
+    int run_benchmarks(int argc, char** argv)
+    {
+        std::string filter;
+        std::string json_path;
+        double min_time_s = 0.2;
+
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+
+            if (arg.rfind("--filter=", 0) == 0)
+                filter = arg.substr(9);
+            else if (arg.rfind("--min-time=", 0) == 0)
+                min_time_s = std::atof(arg.c_str() + 11);
+            else if (arg.rfind("--json=", 0) == 0)
+                json_path = arg.substr(7);
+            else
+            {
+                fprintf(stderr, "Usage: %s [--filter=<substring>] [--min-time=<seconds>] [--json=<path>]\n", argv[0]);
+                return 1;
+            }
+        }
+
+        std::vector<BenchmarkResult> results;
+
+        printf("%-44s %14s %14s %16s\n", "Benchmark", "Time", "Iterations", "Items/s");
+        printf("%s\n", std::string(91, '-').c_str());
+
+        for (auto& benchmark : get_registered_benchmarks())
+        {
+            if (!filter.empty() && benchmark.name.find(filter) == std::string::npos)
+                continue;
+
+            auto result = run_benchmark(benchmark, min_time_s * 1e9);
+
+            char items_per_second[32] = "";
+            if (result.items_per_second > 0)
+                snprintf(items_per_second, sizeof(items_per_second), "%.3gM/s", result.items_per_second / 1e6);
+
+            printf("%-44s %11.1f ns %14llu %16s\n",
+                result.name.c_str(),
+                result.ns_per_iteration,
+                static_cast<unsigned long long>(result.iterations),
+                items_per_second
+            );
+
+            results.push_back(result);
+        }
+
+        if (!json_path.empty())
+            write_json(json_path, results);
+
+        return 0;
+    }
+}
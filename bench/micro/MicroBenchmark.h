@@ -0,0 +1,109 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Minimal microbenchmark harness modeled after Google Benchmark.
+// Each benchmark times the body of a range-based loop over its state,
+// the iteration count grows until a run lasts for the minimum time.
+//
+// YOSEN_BENCHMARK(BM_name)
+// {
+//     for (auto _ : state)
+//         yosen::bench::do_not_optimize(work());
+// }
+namespace yosen::bench
+{
+	class BenchmarkState
+	{
+	public:
+		explicit BenchmarkState(uint64_t iterations)
+			: m_iterations(iterations) {}
+
+		struct Iterator
+		{
+			BenchmarkState* state;
+			uint64_t remaining;
+
+			inline bool operator!=(const Iterator&)
+			{
+				if (remaining)
+					return true;
+
+				state->stop_timer();
+				return false;
+			}
+
+			inline void operator++() { --remaining; }
+			inline int operator*() const { return 0; }
+		};
+
+		inline Iterator begin()
+		{
+			m_start = std::chrono::steady_clock::now();
+			return { this, m_iterations };
+		}
+
+		inline Iterator end() { return { this, 0 }; }
+
+		inline uint64_t iterations() const { return m_iterations; }
+		inline double elapsed_ns() const { return m_elapsed_ns; }
+
+		// Number of items processed by all the iterations, reported as a rate
+		inline void set_items_processed(uint64_t items) { m_items_processed = items; }
+		inline uint64_t items_processed() const { return m_items_processed; }
+
+	private:
+		uint64_t m_iterations;
+		uint64_t m_items_processed = 0;
+		double m_elapsed_ns = 0;
+		std::chrono::steady_clock::time_point m_start;
+
+		inline void stop_timer()
+		{
+			m_elapsed_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - m_start).count();
+		}
+	};
+
+	using benchmark_fn_t = std::function<void(BenchmarkState&)>;
+
+	// Adds a benchmark to the list of benchmarks run by run_benchmarks
+	bool register_benchmark(const std::string& name, benchmark_fn_t fn);
+
+	// Runs the registered benchmarks, accepts the options
+	// --filter=<substring>, --min-time=<seconds> and --json=<path>.
+	int run_benchmarks(int argc, char** argv);
+
+	// Prevents the compiler from optimizing away the computation of a value
+	template <typename T>
+	inline void do_not_optimize(T&& value)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile auto s_sink = &value;
+		s_sink = &value;
+#endif
+	}
+}
+
+#define YOSEN_BENCHMARK_CONCAT_IMPL(a, b) a##b
+#define YOSEN_BENCHMARK_CONCAT(a, b) YOSEN_BENCHMARK_CONCAT_IMPL(a, b)
+
+// Defines and registers a benchmark function
+#define YOSEN_BENCHMARK(fn) \
+	static void fn(yosen::bench::BenchmarkState& state); \
+	static bool YOSEN_BENCHMARK_CONCAT(s_registered_, fn) = yosen::bench::register_benchmark(#fn, fn); \
+	static void fn(yosen::bench::BenchmarkState& state)
+
+// Registers a benchmark function template or a function with bound arguments,
+// the arguments are evaluated once and passed to every run of the benchmark.
+#define YOSEN_BENCHMARK_CAPTURE(fn, name, ...) \
+	static bool YOSEN_BENCHMARK_CONCAT(s_registered_, __LINE__) = yosen::bench::register_benchmark( \
+		#fn "/" #name, [bound_args = std::make_tuple(__VA_ARGS__)](yosen::bench::BenchmarkState& state) { \
+			std::apply([&state](auto&... args) { fn(state, args...); }, bound_args); \
+		} \
+	)
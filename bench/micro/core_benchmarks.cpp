@@ -0,0 +1,389 @@
+#include "MicroBenchmark.h"
+#include <YosenEnvironment.h>
+#include <StackFrame.h>
+#include <primitives/primitives.h>
+#include <algorithm>
+
+// Microbenchmarks of the yosen_lang_core primitives, run without the interpreter
+// to validate allocator, object layout and dispatch changes in isolation.
+//
+// Usage: yosen_microbench [--filter=<substring>] [--min-time=<seconds>] [--json=<path>]
+
+using namespace yosen;
+using yosen::bench::BenchmarkState;
+using yosen::bench::do_not_optimize;
+
+//
+// Allocation
+//
+template <typename T, typename ...Args>
+static void BM_AllocateFree(BenchmarkState& state, Args... args)
+{
+    for ([[maybe_unused]] auto _ : state)
+    {
+        auto obj = allocate_object<T>(args...);
+        do_not_optimize(obj);
+        free_object(obj);
+    }
+}
+
+YOSEN_BENCHMARK_CAPTURE(BM_AllocateFree<YosenObject>, Object);
+YOSEN_BENCHMARK_CAPTURE(BM_AllocateFree<YosenInteger>, Integer, int64_t(42));
+YOSEN_BENCHMARK_CAPTURE(BM_AllocateFree<YosenFloat>, Float, 4.2);
+YOSEN_BENCHMARK_CAPTURE(BM_AllocateFree<YosenBoolean>, Boolean, true);
+YOSEN_BENCHMARK_CAPTURE(BM_AllocateFree<YosenString>, String, std::string("short"));
+YOSEN_BENCHMARK_CAPTURE(BM_AllocateFree<YosenString>, LongString, std::string(64, 'x'));
+YOSEN_BENCHMARK_CAPTURE(BM_AllocateFree<YosenList>, List);
+YOSEN_BENCHMARK_CAPTURE(BM_AllocateFree<YosenTuple>, Tuple);
+
+//
+// Cloning
+//
+static std::vector<YosenObject*> make_integers(size_t count)
+{
+    std::vector<YosenObject*> items;
+    for (size_t i = 0; i < count; ++i)
+        items.push_back(allocate_object<YosenInteger>(static_cast<int64_t>(i)));
+
+    return items;
+}
+
+template <typename T, typename ...Args>
+static void BM_Clone(BenchmarkState& state, Args... args)
+{
+    auto obj = allocate_object<T>(args...);
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        auto copy = obj->clone();
+        do_not_optimize(copy);
+        free_object(copy);
+    }
+
+    free_object(obj);
+}
+
+YOSEN_BENCHMARK_CAPTURE(BM_Clone<YosenInteger>, Integer, int64_t(42));
+YOSEN_BENCHMARK_CAPTURE(BM_Clone<YosenFloat>, Float, 4.2);
+YOSEN_BENCHMARK_CAPTURE(BM_Clone<YosenString>, String, std::string("short"));
+
+YOSEN_BENCHMARK(BM_CloneList16)
+{
+    auto list = allocate_object<YosenList>(make_integers(16));
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        auto copy = list->clone();
+        do_not_optimize(copy);
+        free_object(copy);
+    }
+
+    free_object(list);
+}
+
+//
+// Runtime operators
+//
+template <typename T, typename V>
+static void BM_RuntimeOperator(BenchmarkState& state, V lhs_value, RuntimeOperator op, V rhs_value)
+{
+    auto lhs = allocate_object<T>(lhs_value);
+    auto rhs = allocate_object<T>(rhs_value);
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        auto result = lhs->call_runtime_operator_function(op, rhs);
+        do_not_optimize(result);
+        free_object(result);
+    }
+
+    free_object(lhs);
+    free_object(rhs);
+}
+
+YOSEN_BENCHMARK_CAPTURE(BM_RuntimeOperator<YosenInteger>, IntegerAdd, int64_t(40), RuntimeOperator::BinOpAdd, int64_t(2));
+YOSEN_BENCHMARK_CAPTURE(BM_RuntimeOperator<YosenInteger>, IntegerLess, int64_t(40), RuntimeOperator::BoolOpLessThan, int64_t(2));
+YOSEN_BENCHMARK_CAPTURE(BM_RuntimeOperator<YosenFloat>, FloatMul, 4.0, RuntimeOperator::BinOpMul, 0.5);
+YOSEN_BENCHMARK_CAPTURE(BM_RuntimeOperator<YosenString>, StringAdd, std::string("hello "), RuntimeOperator::BinOpAdd, std::string("world"));
+YOSEN_BENCHMARK_CAPTURE(BM_RuntimeOperator<YosenString>, StringEqu, std::string("hello"), RuntimeOperator::BoolOpEqu, std::string("hello"));
+
+//
+// Argument parsing
+//
+YOSEN_BENCHMARK(BM_ArgParse)
+{
+    YosenObject* objects[] = {
+        allocate_object<YosenInteger>(int64_t(42)),
+        allocate_object<YosenString>(std::string("argument"))
+    };
+
+    YosenArgs args(objects, 2);
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        int64_t number = 0;
+        std::string_view str;
+
+        bool parsed = arg_parse(args, number, str);
+        do_not_optimize(parsed);
+        do_not_optimize(number);
+        do_not_optimize(str);
+    }
+
+    for (auto obj : objects)
+        free_object(obj);
+}
+
+//
+// Stack frames
+//
+static void free_stack_frame_objects(StackFrame& frame)
+{
+    for (auto& [name, obj] : frame.params)
+        if (obj)
+            free_object(obj);
+
+    for (auto& [key, obj] : frame.vars)
+        free_object(obj);
+
+    for (auto& [key, obj] : frame.constants)
+        free_object(obj);
+}
+
+YOSEN_BENCHMARK(BM_StackFrameClone)
+{
+    // Comparable to a small function with two parameters and a few locals
+    auto frame = allocate_stack_frame();
+    frame->name = "function";
+    frame->params.push_back({ "a", nullptr });
+    frame->params.push_back({ "b", nullptr });
+
+    frame->add_variable("i", allocate_object<YosenInteger>(int64_t(0)));
+    frame->add_variable("total", allocate_object<YosenInteger>(int64_t(0)));
+    frame->add_variable("name", allocate_object<YosenString>(std::string("name")));
+
+    frame->constant_keys["1"] = 0;
+    frame->constants[0] = allocate_object<YosenInteger>(int64_t(1));
+    frame->constant_keys["100"] = 1;
+    frame->constants[1] = allocate_object<YosenInteger>(int64_t(100));
+
+    frame->add_function_name("helper");
+    frame->add_function_name("io::println");
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        auto copy = frame->clone();
+        do_not_optimize(copy.get());
+        free_stack_frame_objects(*copy);
+    }
+
+    free_stack_frame_objects(*frame);
+}
+
+//
+// Lists
+//
+YOSEN_BENCHMARK(BM_ListAdd)
+{
+    constexpr size_t max_list_size = 4096;
+
+    auto list = allocate_object<YosenList>();
+    YosenObject* item = allocate_object<YosenInteger>(int64_t(42));
+    YosenArgs args(&item, 1);
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        do_not_optimize(list->call_member_native_function("add", args));
+
+        // Keeps the list from growing without bounds
+        if (list->items.size() == max_list_size)
+        {
+            for (auto obj : list->items)
+                free_object(obj);
+
+            list->items.clear();
+        }
+    }
+
+    free_object(list);
+    free_object(item);
+}
+
+YOSEN_BENCHMARK(BM_ListGet)
+{
+    constexpr int64_t list_size = 1024;
+
+    auto list = allocate_object<YosenList>(make_integers(list_size));
+    auto index = allocate_object<YosenInteger>(int64_t(0));
+    YosenObject* args_data[] = { index };
+    YosenArgs args(args_data, 1);
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        index->value = (index->value + 1) % list_size;
+
+        auto item = list->call_member_native_function("get", args);
+        do_not_optimize(item);
+        free_object(item);
+    }
+
+    free_object(list);
+    free_object(index);
+}
+
+//
+// String kernels
+//
+// Log-like text without any matches, so searches scan the whole buffer
+static std::string make_log_text(size_t size)
+{
+    std::string text;
+    while (text.size() < size)
+        text += "2024-05-01 12:00:03 GET /index.html 200 1532\n";
+
+    text.resize(size);
+    return text;
+}
+
+YOSEN_BENCHMARK(BM_StringKernelFind)
+{
+    auto text = make_log_text(64 * 1024);
+
+    for ([[maybe_unused]] auto _ : state)
+        do_not_optimize(string_kernels::find(text, "ERROR"));
+
+    state.set_items_processed(state.iterations() * text.size());
+}
+
+YOSEN_BENCHMARK(BM_StdStringFind)
+{
+    auto text = make_log_text(64 * 1024);
+
+    for ([[maybe_unused]] auto _ : state)
+        do_not_optimize(text.find("ERROR"));
+
+    state.set_items_processed(state.iterations() * text.size());
+}
+
+YOSEN_BENCHMARK(BM_StringKernelCountByte)
+{
+    auto text = make_log_text(64 * 1024);
+
+    for ([[maybe_unused]] auto _ : state)
+        do_not_optimize(string_kernels::count_byte(text, '\n'));
+
+    state.set_items_processed(state.iterations() * text.size());
+}
+
+YOSEN_BENCHMARK(BM_StdCountByte)
+{
+    auto text = make_log_text(64 * 1024);
+
+    for ([[maybe_unused]] auto _ : state)
+        do_not_optimize(std::count(text.begin(), text.end(), '\n'));
+
+    state.set_items_processed(state.iterations() * text.size());
+}
+
+YOSEN_BENCHMARK(BM_StringKernelToUpper)
+{
+    auto text = make_log_text(64 * 1024);
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        string_kernels::to_upper(text);
+        do_not_optimize(text.data());
+    }
+
+    state.set_items_processed(state.iterations() * text.size());
+}
+
+YOSEN_BENCHMARK(BM_StringKernelIsAscii)
+{
+    auto text = make_log_text(64 * 1024);
+
+    for ([[maybe_unused]] auto _ : state)
+        do_not_optimize(string_kernels::is_ascii(text));
+
+    state.set_items_processed(state.iterations() * text.size());
+}
+
+//
+// Environment lookups
+//
+YOSEN_BENCHMARK(BM_EnvStaticNativeFunction)
+{
+    auto& env = YosenEnvironment::get();
+    const std::string name = "str";
+
+    for ([[maybe_unused]] auto _ : state)
+        do_not_optimize(env.get_static_native_function(name));
+}
+
+YOSEN_BENCHMARK(BM_EnvGlobalVariableByName)
+{
+    auto& env = YosenEnvironment::get();
+    const std::string name = "workload_global";
+
+    for ([[maybe_unused]] auto _ : state)
+        do_not_optimize(env.get_global_variable(name));
+}
+
+YOSEN_BENCHMARK(BM_EnvGlobalVariableByKey)
+{
+    auto& env = YosenEnvironment::get();
+    auto key = env.get_global_variable_index("workload_global");
+
+    for ([[maybe_unused]] auto _ : state)
+        do_not_optimize(env.get_global_variable(key));
+}
+
+YOSEN_BENCHMARK(BM_EnvIsClassName)
+{
+    auto& env = YosenEnvironment::get();
+    const std::string name = "BenchClass";
+
+    for ([[maybe_unused]] auto _ : state)
+        do_not_optimize(env.is_class_name(name));
+}
+
+YOSEN_BENCHMARK(BM_EnvConstructClassInstance)
+{
+    auto& env = YosenEnvironment::get();
+    const std::string name = "BenchClass";
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        auto instance = env.construct_class_instance(name, YosenArgs());
+        do_not_optimize(instance);
+        free_object(instance);
+    }
+}
+
+// Globals and classes looked up by the environment benchmarks,
+// mixed with others so the lookups don't hit trivially small tables.
+static void populate_environment()
+{
+    auto& env = YosenEnvironment::get();
+
+    for (int i = 0; i < 32; ++i)
+        env.register_global_variable("global_" + std::to_string(i), allocate_object<YosenInteger>(int64_t(i)));
+
+    env.register_global_variable("workload_global", allocate_object<YosenInteger>(int64_t(42)));
+
+    for (int i = 0; i < 8; ++i)
+        env.create_runtime_class_builder("Class" + std::to_string(i))->create_runtime_class();
+
+    auto builder = env.create_runtime_class_builder("BenchClass");
+    builder->member_variables["x"] = allocate_object<YosenInteger>(int64_t(0));
+    builder->member_variables["name"] = allocate_object<YosenString>(std::string("bench"));
+    builder->create_runtime_class();
+}
+
+int main(int argc, char** argv)
+{
+    YosenEnvironment::init();
+    populate_environment();
+
+    return yosen::bench::run_benchmarks(argc, argv);
+}
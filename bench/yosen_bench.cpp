@@ -0,0 +1,293 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Runs Yosen scripts repeatedly in separate interpreter processes and
+// reports their wall time, allocations and peak memory usage as JSON.
+//
+// Usage: yosen_bench --yosen <interpreter> [--runs N] [--warmup N] [--output file.json] <script.ys>...
+
+struct RunResult
+{
+    bool succeeded = false;
+    double wall_time_ms = 0;
+    uint64_t allocations = 0;
+    uint64_t peak_live_shallow_bytes = 0;
+    uint64_t peak_rss_kb = 0;
+};
+
+struct BenchmarkResult
+{
+    std::string name;
+    std::string path;
+    std::vector<RunResult> runs;
+    size_t failed_runs = 0;
+};
+
+static uint64_t parse_report_value(const std::string& report, const char* key)
+{
+    auto pos = report.find(key);
+    if (pos == std::string::npos)
+        return 0;
+
+    return std::strtoull(report.c_str() + pos + strlen(key), nullptr, 10);
+}
+
+static RunResult run_script(const std::string& interpreter_path, const std::string& script_path)
+{
+    RunResult result;
+
+    int report_pipe[2];
+    if (pipe(report_pipe) != 0)
+        return result;
+
+    auto start = std::chrono::steady_clock::now();
+
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        // The script's output isn't part of the results
+        int null_fd = open("/dev/null", O_WRONLY);
+        dup2(null_fd, STDOUT_FILENO);
+        dup2(report_pipe[1], STDERR_FILENO);
+
+        close(report_pipe[0]);
+        close(report_pipe[1]);
+
+        execl(interpreter_path.c_str(), interpreter_path.c_str(), "--alloc-stats", script_path.c_str(), nullptr);
+        _exit(127);
+    }
+
+    close(report_pipe[1]);
+
+    // Read the allocation report written to stderr
+    std::string report;
+    char buffer[4096];
+    ssize_t bytes_read;
+
+    while ((bytes_read = read(report_pipe[0], buffer, sizeof(buffer))) > 0)
+        report.append(buffer, static_cast<size_t>(bytes_read));
+
+    close(report_pipe[0]);
+
+    int status = 0;
+    rusage usage = {};
+    if (pid < 0 || wait4(pid, &status, 0, &usage) != pid)
+        return result;
+
+    auto end = std::chrono::steady_clock::now();
+
+    result.succeeded = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    result.wall_time_ms = std::chrono::duration<double, std::milli>(end - start).count();
+    result.allocations = parse_report_value(report, "allocations: ");
+    result.peak_live_shallow_bytes = parse_report_value(report, "peak_live_shallow_bytes: ");
+
+#ifdef __APPLE__
+    // Reported in bytes on macOS
+    result.peak_rss_kb = static_cast<uint64_t>(usage.ru_maxrss) / 1024;
+#else
+    result.peak_rss_kb = static_cast<uint64_t>(usage.ru_maxrss);
+#endif
+
+    return result;
+}
+
+// Nearest-rank percentile of sorted values
+static double percentile(const std::vector<double>& sorted_values, double pct)
+{
+    if (sorted_values.empty())
+        return 0;
+
+    auto rank = static_cast<size_t>(pct / 100.0 * sorted_values.size() + 0.999999);
+    return sorted_values[std::clamp<size_t>(rank, 1, sorted_values.size()) - 1];
+}
+
+static double median(const std::vector<double>& sorted_values)
+{
+    if (sorted_values.empty())
+        return 0;
+
+    auto mid = sorted_values.size() / 2;
+    if (sorted_values.size() % 2)
+        return sorted_values[mid];
+
+    return (sorted_values[mid - 1] + sorted_values[mid]) / 2;
+}
+
+static std::string escape_json(const std::string& str)
+{
+    std::string result;
+    for (auto c : str)
+    {
+        if (c == '"' || c == '\\')
+            result += '\\';
+
+        result += c;
+    }
+
+    return result;
+}
+
+static void write_json(FILE* file, const std::string& interpreter_path, size_t run_count, const std::vector<BenchmarkResult>& results)
+{
+    fprintf(file, "{\n");
+    fprintf(file, "  \"interpreter\": \"%s\",\n", escape_json(interpreter_path).c_str());
+    fprintf(file, "  \"runs\": %zu,\n", run_count);
+    fprintf(file, "  \"benchmarks\": [\n");
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        auto& benchmark = results[i];
+
+        std::vector<double> times;
+        uint64_t allocations = 0, peak_live_shallow_bytes = 0, peak_rss_kb = 0;
+
+        for (auto& run : benchmark.runs)
+        {
+            times.push_back(run.wall_time_ms);
+
+            // Allocations are deterministic, memory usage is reported at its worst
+            allocations = run.allocations;
+            peak_live_shallow_bytes = std::max(peak_live_shallow_bytes, run.peak_live_shallow_bytes);
+            peak_rss_kb = std::max(peak_rss_kb, run.peak_rss_kb);
+        }
+
+        std::sort(times.begin(), times.end());
+
+        fprintf(file, "    {\n");
+        fprintf(file, "      \"name\": \"%s\",\n", escape_json(benchmark.name).c_str());
+        fprintf(file, "      \"script\": \"%s\",\n", escape_json(benchmark.path).c_str());
+        fprintf(file, "      \"successful_runs\": %zu,\n", benchmark.runs.size());
+        fprintf(file, "      \"failed_runs\": %zu,\n", benchmark.failed_runs);
+        fprintf(file, "      \"median_ms\": %.3f,\n", median(times));
+        fprintf(file, "      \"p95_ms\": %.3f,\n", percentile(times, 95));
+        fprintf(file, "      \"min_ms\": %.3f,\n", times.empty() ? 0.0 : times.front());
+        fprintf(file, "      \"max_ms\": %.3f,\n", times.empty() ? 0.0 : times.back());
+        fprintf(file, "      \"allocations\": %llu,\n", static_cast<unsigned long long>(allocations));
+        fprintf(file, "      \"peak_live_shallow_bytes\": %llu,\n", static_cast<unsigned long long>(peak_live_shallow_bytes));
+        fprintf(file, "      \"peak_rss_kb\": %llu\n", static_cast<unsigned long long>(peak_rss_kb));
+        fprintf(file, "    }%s\n", (i + 1 < results.size()) ? "," : "");
+    }
+
+    fprintf(file, "  ]\n");
+    fprintf(file, "}\n");
+}
+
+int main(int argc, char** argv)
+{
+    std::string interpreter_path;
+    std::string output_path;
+    size_t run_count = 10;
+    size_t warmup_count = 1;
+    std::vector<std::string> script_paths;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        bool has_value = (i + 1 < argc);
+
+        if (arg == "--yosen" && has_value)
+            interpreter_path = argv[++i];
+        else if (arg == "--output" && has_value)
+            output_path = argv[++i];
+        else if (arg == "--runs" && has_value)
+            run_count = std::max(std::strtoul(argv[++i], nullptr, 10), 1ul);
+        else if (arg == "--warmup" && has_value)
+            warmup_count = std::strtoul(argv[++i], nullptr, 10);
+        else if (arg.rfind("--", 0) == 0)
+        {
+            fprintf(stderr, "Unknown option \"%s\"\n", arg.c_str());
+            return 1;
+        }
+        else
+            script_paths.push_back(arg);
+    }
+
+    if (interpreter_path.empty() || script_paths.empty())
+    {
+        fprintf(stderr, "Usage: %s --yosen <interpreter> [--runs N] [--warmup N] [--output file.json] <script.ys>...\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<BenchmarkResult> results;
+    bool all_succeeded = true;
+
+    printf("%-20s %10s %10s %14s %12s\n", "benchmark", "median ms", "p95 ms", "allocations", "peak rss kb");
+
+    for (auto& script_path : script_paths)
+    {
+        BenchmarkResult benchmark;
+        benchmark.name = std::filesystem::path(script_path).stem().string();
+        benchmark.path = script_path;
+
+        for (size_t i = 0; i < warmup_count; ++i)
+            run_script(interpreter_path, script_path);
+
+        for (size_t i = 0; i < run_count; ++i)
+        {
+            auto run = run_script(interpreter_path, script_path);
+
+            if (run.succeeded)
+                benchmark.runs.push_back(run);
+            else
+                ++benchmark.failed_runs;
+        }
+
+        std::vector<double> times;
+        uint64_t peak_rss_kb = 0;
+
+        for (auto& run : benchmark.runs)
+        {
+            times.push_back(run.wall_time_ms);
+            peak_rss_kb = std::max(peak_rss_kb, run.peak_rss_kb);
+        }
+
+        std::sort(times.begin(), times.end());
+
+        if (benchmark.failed_runs)
+        {
+            all_succeeded = false;
+            printf("%-20s failed %zu of %zu runs\n", benchmark.name.c_str(), benchmark.failed_runs, run_count);
+        }
+        else
+        {
+            printf("%-20s %10.2f %10.2f %14llu %12llu\n",
+                benchmark.name.c_str(),
+                median(times),
+                percentile(times, 95),
+                static_cast<unsigned long long>(benchmark.runs.back().allocations),
+                static_cast<unsigned long long>(peak_rss_kb)
+            );
+        }
+
+        results.push_back(std::move(benchmark));
+    }
+
+    if (!output_path.empty())
+    {
+        auto file = fopen(output_path.c_str(), "w");
+        if (!file)
+        {
+            fprintf(stderr, "Failed to write the results to \"%s\"\n", output_path.c_str());
+            return 1;
+        }
+
+        write_json(file, interpreter_path, run_count, results);
+        fclose(file);
+
+        printf("Results written to %s\n", output_path.c_str());
+    }
+    else
+        write_json(stdout, interpreter_path, run_count, results);
+
+    return all_succeeded ? 0 : 1;
+}
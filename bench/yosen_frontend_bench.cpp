@@ -0,0 +1,561 @@
+#include <parser/Parser.h>
+#include <interpreter/YosenCompiler.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __APPLE__
+    #include <malloc/malloc.h>
+    #define yosen_bench_allocation_size malloc_size
+#else
+    #include <malloc.h>
+    #define yosen_bench_allocation_size malloc_usable_size
+#endif
+
+// Measures the throughput of the lexer, parser and compiler on synthetic
+// Yosen programs of increasing size and estimates how each phase scales.
+// A phase whose time grows faster than linearly with the source size
+// shows up with a scaling exponent well above 1.
+//
+// Usage: yosen_frontend_bench [--units N,N,...] [--depth N] [--rounds N]
+//                             [--max-exponent X] [--output file.json] [--dump file.ys]
+
+using namespace yosen;
+
+//
+// Heap usage tracking, the allocations are still served by malloc
+// so memory allocated by the core library can be freed here and vice versa.
+//
+static std::atomic<int64_t> s_heap_bytes = 0;
+static std::atomic<int64_t> s_peak_heap_bytes = 0;
+
+static void* tracked_allocate(size_t size)
+{
+    auto ptr = malloc(size ? size : 1);
+    if (!ptr)
+        throw std::bad_alloc();
+
+    auto allocation_size = static_cast<int64_t>(yosen_bench_allocation_size(ptr));
+    auto bytes = s_heap_bytes.fetch_add(allocation_size, std::memory_order_relaxed) + allocation_size;
+
+    auto peak = s_peak_heap_bytes.load(std::memory_order_relaxed);
+    while (bytes > peak && !s_peak_heap_bytes.compare_exchange_weak(peak, bytes, std::memory_order_relaxed));
+
+    return ptr;
+}
+
+static void tracked_free(void* ptr)
+{
+    if (!ptr)
+        return;
+
+    s_heap_bytes.fetch_sub(yosen_bench_allocation_size(ptr), std::memory_order_relaxed);
+    free(ptr);
+}
+
+void* operator new(size_t size) { return tracked_allocate(size); }
+void* operator new[](size_t size) { return tracked_allocate(size); }
+void operator delete(void* ptr) noexcept { tracked_free(ptr); }
+void operator delete[](void* ptr) noexcept { tracked_free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { tracked_free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { tracked_free(ptr); }
+
+// Starts measuring the peak heap usage from the current usage
+static int64_t reset_peak_heap_bytes()
+{
+    auto bytes = s_heap_bytes.load();
+    s_peak_heap_bytes = bytes;
+
+    return bytes;
+}
+
+//
+// Source generation
+//
+struct GeneratorOptions
+{
+    size_t units = 0;
+    size_t expression_depth = 4;
+};
+
+static const char* s_binary_operators[] = { "+", "-", "*", "/" };
+
+// Nested arithmetic expression over the parameters a and b
+static void generate_expression(std::ostringstream& out, size_t depth, size_t seed)
+{
+    if (depth == 0)
+    {
+        if (seed % 3 == 0)
+            out << "a";
+        else if (seed % 3 == 1)
+            out << "b";
+        else
+            out << (seed % 97 + 1);
+
+        return;
+    }
+
+    auto op = s_binary_operators[seed % 4];
+
+    out << "(";
+    generate_expression(out, depth - 1, seed * 7 + 1);
+    out << " " << op << " ";
+
+    // Divisors are non-zero literals so the generated program can also be run
+    if (op[0] == '/')
+        out << (seed % 7 + 2);
+    else
+        generate_expression(out, depth / 2, seed * 13 + 5);
+
+    out << ")";
+}
+
+// Each unit is a free function with loops, conditionals and nested
+// expressions, and a class with member variables and member functions.
+static std::string generate_source(const GeneratorOptions& options)
+{
+    std::ostringstream out;
+
+    for (size_t i = 0; i < options.units; ++i)
+    {
+        out << "func fn_" << i << "(a, b)\n{\n";
+        out << "\tvar x = ";
+        generate_expression(out, options.expression_depth, i);
+        out << ";\n";
+        out << "\tvar total = 0;\n";
+        out << "\tvar label = \"fn_" << i << "\";\n\n";
+        out << "\tfor (var k = 0; k < 10; k += 1)\n\t{\n";
+        out << "\t\tif ((x > k) && (total < 1000))\n\t\t{\n";
+        out << "\t\t\ttotal = total + x * k;\n";
+        out << "\t\t}\n\t\telse\n\t\t{\n";
+        out << "\t\t\ttotal = total - 1;\n";
+        out << "\t\t}\n\t}\n\n";
+        out << "\twhile (total > 100)\n\t{\n";
+        out << "\t\ttotal = total / 2;\n";
+        out << "\t}\n\n";
+
+        if (i > 0)
+            out << "\treturn fn_" << (i - 1) << "(total, x);\n";
+        else
+            out << "\treturn total;\n";
+
+        out << "}\n\n";
+
+        out << "class Class_" << i << "\n{\n";
+        out << "\tvar count = 0;\n";
+        out << "\tvar name = \"Class_" << i << "\";\n\n";
+        out << "\tfunc Class_" << i << "(self, start)\n\t{\n";
+        out << "\t\tself.count = start;\n";
+        out << "\t}\n\n";
+        out << "\tfunc step(self, amount)\n\t{\n";
+        out << "\t\tself.count = self.count + amount * " << (i % 5 + 1) << ";\n";
+        out << "\t\treturn self.count;\n";
+        out << "\t}\n\n";
+        out << "\tfunc create()\n\t{\n";
+        out << "\t\treturn new Class_" << i << "(" << i << ");\n";
+        out << "\t}\n";
+        out << "}\n\n";
+    }
+
+    out << "func main()\n{\n";
+    out << "\tvar obj = Class_0::create();\n";
+    out << "\tobj.step(2);\n";
+    out << "\tvar result = fn_" << (options.units ? options.units - 1 : 0) << "(1, 2);\n";
+    out << "}\n";
+
+    return out.str();
+}
+
+//
+// Measurement
+//
+struct PhaseResult
+{
+    double seconds = 0;
+    int64_t peak_heap_bytes = 0;
+};
+
+struct SizeResult
+{
+    size_t units = 0;
+    size_t source_bytes = 0;
+    size_t tokens = 0;
+    size_t nodes = 0;
+    size_t bytecode_bytes = 0;
+
+    PhaseResult lex;
+    PhaseResult parse;
+    PhaseResult compile;
+};
+
+static size_t count_ast_nodes(const json11::Json& node)
+{
+    size_t count = 0;
+
+    if (node.is_object())
+    {
+        ++count;
+        for (auto& [key, value] : node.object_items())
+            count += count_ast_nodes(value);
+    }
+    else if (node.is_array())
+    {
+        for (auto& item : node.array_items())
+            count += count_ast_nodes(item);
+    }
+
+    return count;
+}
+
+static size_t count_bytecode_bytes(const ProgramSource& program_source, YosenEnvironment& env, size_t units)
+{
+    size_t bytes = 0;
+
+    for (auto& [stack_frame, bytecode] : program_source.runtime_functions)
+        bytes += bytecode.size() * sizeof(opcodes::opcode_t);
+
+    // Member functions are registered in the class builders
+    for (size_t i = 0; i < units; ++i)
+    {
+        auto class_name = "Class_" + std::to_string(i);
+        if (!env.is_class_name(class_name))
+            continue;
+
+        auto instance = env.construct_class_instance(class_name, YosenArgs());
+
+        for (auto fn_name : { class_name, std::string("step") })
+            if (instance->has_member_runtime_function(fn_name))
+                bytes += instance->get_member_runtime_function(fn_name).second.size() * sizeof(opcodes::opcode_t);
+
+        free_object(instance);
+    }
+
+    return bytes;
+}
+
+static bool s_exception_thrown = false;
+
+static void register_exception_handler(YosenEnvironment& env)
+{
+    env.register_exception_handler([](const YosenException& ex) {
+        if (!s_exception_thrown)
+            fprintf(stderr, "%s\n", ex.to_string().c_str());
+
+        s_exception_thrown = true;
+    });
+}
+
+template <typename Fn>
+static PhaseResult measure_phase(Fn&& fn)
+{
+    PhaseResult result;
+    auto heap_baseline = reset_peak_heap_bytes();
+    auto start = std::chrono::steady_clock::now();
+
+    fn();
+
+    auto end = std::chrono::steady_clock::now();
+    result.seconds = std::chrono::duration<double>(end - start).count();
+    result.peak_heap_bytes = s_peak_heap_bytes.load() - heap_baseline;
+
+    return result;
+}
+
+// Keeps the fastest time and the largest peak memory of all the rounds
+static void merge_phase_result(PhaseResult& best, const PhaseResult& round, bool first_round)
+{
+    best.seconds = first_round ? round.seconds : std::min(best.seconds, round.seconds);
+    best.peak_heap_bytes = std::max(best.peak_heap_bytes, round.peak_heap_bytes);
+}
+
+static SizeResult measure_size(const GeneratorOptions& options, size_t rounds)
+{
+    SizeResult result;
+    result.units = options.units;
+
+    auto source = generate_source(options);
+    result.source_bytes = source.size();
+
+    for (size_t round = 0; round < rounds; ++round)
+    {
+        bool first_round = (round == 0);
+
+        // Lexing
+        std::shared_ptr<parser::TokenPool> token_pool;
+        auto lex_source = source;
+        parser::Lexer lexer;
+
+        auto lex = measure_phase([&]() {
+            token_pool = lexer.construct_token_pool(lex_source);
+        });
+
+        result.tokens = token_pool->get_all_tokens().size();
+        token_pool.reset();
+
+        // Parsing
+        parser::AST ast;
+        auto parse_source = source;
+        parser::Parser parser;
+
+        auto parse = measure_phase([&]() {
+            ast = parser.parse_source(parse_source);
+        });
+
+        result.nodes = count_ast_nodes(ast);
+
+        // Compiling into a fresh environment that doesn't keep the previous round's classes
+        auto env = YosenEnvironment::create();
+        register_exception_handler(*env);
+
+        {
+            YosenEnvironmentScope env_scope(env.get());
+
+            YosenCompiler compiler;
+            compiler.init(env.get());
+
+            ProgramSource program_source;
+
+            auto compile = measure_phase([&]() {
+                program_source = compiler.compile_program_ast(ast, "frontend_bench.ys");
+            });
+
+            result.bytecode_bytes = count_bytecode_bytes(program_source, *env, options.units);
+            compiler.shutdown();
+
+            merge_phase_result(result.compile, compile, first_round);
+        }
+
+        merge_phase_result(result.lex, lex, first_round);
+        merge_phase_result(result.parse, parse, first_round);
+    }
+
+    // The parser runs its own lexer, so the lexing time is subtracted
+    result.parse.seconds = std::max(result.parse.seconds - result.lex.seconds, 0.0);
+
+    return result;
+}
+
+// Least squares slope of log(time) over log(units)
+static double scaling_exponent(const std::vector<SizeResult>& results, PhaseResult SizeResult::* phase)
+{
+    double sum_x = 0, sum_y = 0, sum_xx = 0, sum_xy = 0;
+    double n = 0;
+
+    for (auto& result : results)
+    {
+        // Times below the clock resolution can't be compared
+        if ((result.*phase).seconds <= 0)
+            continue;
+
+        double x = std::log(static_cast<double>(result.units));
+        double y = std::log((result.*phase).seconds);
+        ++n;
+
+        sum_x += x;
+        sum_y += y;
+        sum_xx += x * x;
+        sum_xy += x * y;
+    }
+
+    double denominator = n * sum_xx - sum_x * sum_x;
+    if (n < 2 || denominator == 0)
+        return 0;
+
+    return (n * sum_xy - sum_x * sum_y) / denominator;
+}
+
+static double rate(size_t count, double seconds)
+{
+    return seconds > 0 ? count / seconds : 0;
+}
+
+static void write_json(
+    FILE* file,
+    const GeneratorOptions& options,
+    const std::vector<SizeResult>& results,
+    const std::vector<std::pair<const char*, double>>& exponents
+)
+{
+    fprintf(file, "{\n");
+    fprintf(file, "  \"expression_depth\": %zu,\n", options.expression_depth);
+    fprintf(file, "  \"sizes\": [\n");
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        auto& result = results[i];
+
+        fprintf(file, "    {\n");
+        fprintf(file, "      \"units\": %zu,\n", result.units);
+        fprintf(file, "      \"source_bytes\": %zu,\n", result.source_bytes);
+        fprintf(file, "      \"tokens\": %zu,\n", result.tokens);
+        fprintf(file, "      \"nodes\": %zu,\n", result.nodes);
+        fprintf(file, "      \"bytecode_bytes\": %zu,\n", result.bytecode_bytes);
+        fprintf(file, "      \"lex_ms\": %.3f,\n", result.lex.seconds * 1e3);
+        fprintf(file, "      \"parse_ms\": %.3f,\n", result.parse.seconds * 1e3);
+        fprintf(file, "      \"compile_ms\": %.3f,\n", result.compile.seconds * 1e3);
+        fprintf(file, "      \"tokens_per_second\": %.1f,\n", rate(result.tokens, result.lex.seconds));
+        fprintf(file, "      \"nodes_per_second\": %.1f,\n", rate(result.nodes, result.parse.seconds));
+        fprintf(file, "      \"bytecode_bytes_per_second\": %.1f,\n", rate(result.bytecode_bytes, result.compile.seconds));
+        fprintf(file, "      \"lex_peak_heap_bytes\": %lld,\n", static_cast<long long>(result.lex.peak_heap_bytes));
+        fprintf(file, "      \"parse_peak_heap_bytes\": %lld,\n", static_cast<long long>(result.parse.peak_heap_bytes));
+        fprintf(file, "      \"compile_peak_heap_bytes\": %lld\n", static_cast<long long>(result.compile.peak_heap_bytes));
+        fprintf(file, "    }%s\n", (i + 1 < results.size()) ? "," : "");
+    }
+
+    fprintf(file, "  ],\n");
+    fprintf(file, "  \"scaling_exponents\": {\n");
+
+    for (size_t i = 0; i < exponents.size(); ++i)
+        fprintf(file, "    \"%s\": %.3f%s\n", exponents[i].first, exponents[i].second, (i + 1 < exponents.size()) ? "," : "");
+
+    fprintf(file, "  }\n");
+    fprintf(file, "}\n");
+}
+
+static std::vector<size_t> parse_size_list(const char* str)
+{
+    std::vector<size_t> sizes;
+    std::stringstream stream(str);
+    std::string item;
+
+    while (std::getline(stream, item, ','))
+    {
+        auto size = std::strtoul(item.c_str(), nullptr, 10);
+        if (size)
+            sizes.push_back(size);
+    }
+
+    std::sort(sizes.begin(), sizes.end());
+    return sizes;
+}
+
+int main(int argc, char** argv)
+{
+    GeneratorOptions options;
+    std::vector<size_t> unit_counts = { 50, 100, 200, 400 };
+    size_t rounds = 3;
+    double max_exponent = 0;
+    std::string output_path;
+    std::string dump_path;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        bool has_value = (i + 1 < argc);
+
+        if (arg == "--units" && has_value)
+            unit_counts = parse_size_list(argv[++i]);
+        else if (arg == "--depth" && has_value)
+            options.expression_depth = std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--rounds" && has_value)
+            rounds = std::max(std::strtoul(argv[++i], nullptr, 10), 1ul);
+        else if (arg == "--max-exponent" && has_value)
+            max_exponent = std::atof(argv[++i]);
+        else if (arg == "--output" && has_value)
+            output_path = argv[++i];
+        else if (arg == "--dump" && has_value)
+            dump_path = argv[++i];
+        else
+        {
+            fprintf(stderr, "Usage: %s [--units N,N,...] [--depth N] [--rounds N] [--max-exponent X] [--output file.json] [--dump file.ys]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (unit_counts.empty())
+    {
+        fprintf(stderr, "No program sizes to measure\n");
+        return 1;
+    }
+
+    YosenEnvironment::init();
+    register_exception_handler(YosenEnvironment::get());
+
+    if (!dump_path.empty())
+    {
+        options.units = unit_counts.back();
+
+        auto file = fopen(dump_path.c_str(), "w");
+        if (file)
+        {
+            auto source = generate_source(options);
+            fwrite(source.data(), 1, source.size(), file);
+            fclose(file);
+        }
+    }
+
+    std::vector<SizeResult> results;
+
+    printf("%8s %10s %9s %9s %10s %12s %12s %12s %10s\n",
+        "units", "tokens", "nodes", "bytecode", "lex ms", "parse ms", "compile ms", "tokens/s", "peak KB");
+
+    for (auto units : unit_counts)
+    {
+        options.units = units;
+        auto result = measure_size(options, rounds);
+
+        if (s_exception_thrown)
+        {
+            fprintf(stderr, "The generated program of %zu units failed to compile\n", units);
+            return 1;
+        }
+
+        auto peak_heap_bytes = std::max({ result.lex.peak_heap_bytes, result.parse.peak_heap_bytes, result.compile.peak_heap_bytes });
+
+        printf("%8zu %10zu %9zu %9zu %10.2f %12.2f %12.2f %12.0f %10lld\n",
+            result.units,
+            result.tokens,
+            result.nodes,
+            result.bytecode_bytes,
+            result.lex.seconds * 1e3,
+            result.parse.seconds * 1e3,
+            result.compile.seconds * 1e3,
+            rate(result.tokens, result.lex.seconds),
+            static_cast<long long>(peak_heap_bytes / 1024)
+        );
+
+        results.push_back(result);
+    }
+
+    std::vector<std::pair<const char*, double>> exponents = {
+        { "lex",        scaling_exponent(results, &SizeResult::lex)     },
+        { "parse",      scaling_exponent(results, &SizeResult::parse)   },
+        { "compile",    scaling_exponent(results, &SizeResult::compile) },
+    };
+
+    bool superlinear = false;
+
+    printf("\nScaling exponents (1.0 is linear, 2.0 is quadratic):\n");
+    for (auto& [phase, exponent] : exponents)
+    {
+        bool exceeded = (max_exponent > 0 && exponent > max_exponent);
+        superlinear |= exceeded;
+
+        printf("  %-8s %.2f%s\n", phase, exponent, exceeded ? "  exceeds the maximum" : "");
+    }
+
+    if (!output_path.empty())
+    {
+        auto file = fopen(output_path.c_str(), "w");
+        if (!file)
+        {
+            fprintf(stderr, "Failed to write the results to \"%s\"\n", output_path.c_str());
+            return 1;
+        }
+
+        write_json(file, options, results, exponents);
+        fclose(file);
+
+        printf("Results written to %s\n", output_path.c_str());
+    }
+
+    return superlinear ? 1 : 0;
+}
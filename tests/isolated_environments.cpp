@@ -0,0 +1,92 @@
+#include <interpreter/YosenInterpreter.h>
+#include <thread>
+#include <cstdio>
+using namespace yosen;
+
+// Runs a program in several isolated environments at the same time. Every
+// environment defines its own global values and function, none of which
+// may be visible from any of the other environments.
+constexpr int EnvironmentCount = 4;
+constexpr int IterationCount = 100000;
+
+static std::string make_program_source(int env_idx)
+{
+    auto idx = std::to_string(env_idx);
+
+    return
+        "var g_env_idx = " + idx + ";\n"
+        "var g_total = 0;\n"
+        "\n"
+        "func only_in_env_" + idx + "() {\n"
+        "    return g_env_idx;\n"
+        "}\n"
+        "\n"
+        "func main() {\n"
+        "    for (var i = 0; i < " + std::to_string(IterationCount) + "; i += 1) {\n"
+        "        g_total = g_total + only_in_env_" + idx + "();\n"
+        "    }\n"
+        "}\n";
+}
+
+static bool check_integer_global(YosenEnvironment& env, const std::string& name, int64_t expected)
+{
+    if (!env.is_global_variable(name))
+        return false;
+
+    auto value = env.get_global_variable(name);
+    return value && value->is<YosenInteger>() && value->as<YosenInteger>()->value == expected;
+}
+
+static bool check_environment(YosenEnvironment& env, int env_idx)
+{
+    bool isolated = check_integer_global(env, "g_env_idx", env_idx) &&
+        check_integer_global(env, "g_total", static_cast<int64_t>(env_idx) * IterationCount);
+
+    // Only the environment's own function may be defined
+    for (int i = 0; i < EnvironmentCount; ++i)
+    {
+        bool defined = env.is_static_runtime_function("only_in_env_" + std::to_string(i));
+        if (defined != (i == env_idx))
+            isolated = false;
+    }
+
+    return isolated;
+}
+
+int main()
+{
+    std::vector<std::unique_ptr<YosenEnvironment>> environments(EnvironmentCount);
+    std::vector<std::unique_ptr<YosenInterpreter>> interpreters(EnvironmentCount);
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < EnvironmentCount; ++i)
+    {
+        threads.emplace_back([&environments, &interpreters, i]() {
+            environments[i] = YosenEnvironment::create();
+
+            interpreters[i] = std::make_unique<YosenInterpreter>();
+            interpreters[i]->init(environments[i].get());
+
+            auto source = make_program_source(i);
+            interpreters[i]->run_source(source, { "isolated_environments.ys" });
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    int failed_count = 0;
+
+    for (int i = 0; i < EnvironmentCount; ++i)
+    {
+        bool isolated = check_environment(*environments[i], i);
+        printf("Environment %i: %s\n", i, isolated ? "isolated" : "FAILED");
+
+        if (!isolated)
+            ++failed_count;
+
+        interpreters[i]->shutdown();
+    }
+
+    return failed_count ? 1 : 0;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <string>
+
+namespace yosen
+{
+	enum class CallStackEntryType
+	{
+		Function,				// runtime or native function, name is already qualified
+		NativeMemberFunction,	// native function called on an object
+		Constructor,			// constructor of a runtime class
+	};
+
+	// Entry of the call stack used for tracebacks and profiling. The names
+	// are owned by the stack frames that stay alive during the call and only
+	// get formatted when needed, so making a call doesn't allocate strings.
+	struct CallStackEntry
+	{
+		CallStackEntryType type = CallStackEntryType::Function;
+
+		// Name of the function, or the class name of a constructor
+		const std::string* name = nullptr;
+
+		// Runtime name of the object a native member function is called on
+		const char* receiver_name = nullptr;
+
+		// Appends the displayed name of the function to the string
+		inline void append_name(std::string& str) const
+		{
+			switch (type)
+			{
+			case CallStackEntryType::NativeMemberFunction:
+				str += receiver_name;
+				str += "::";
+				str += *name;
+				break;
+			case CallStackEntryType::Constructor:
+				str += *name;
+				str += "::constructor";
+				break;
+			default:
+				str += *name;
+				break;
+			}
+		}
+	};
+}
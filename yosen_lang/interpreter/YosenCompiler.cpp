@@ -3,6 +3,8 @@
 #include <sstream>
 #include <fstream>
 #include <iostream>
+#include <thread>
+#include <atomic>
 
 namespace yosen
 {
@@ -11,19 +13,16 @@ namespace yosen
         if (ending.size() > value.size()) return false;
         return std::equal(ending.rbegin(), ending.rend(), value.rbegin());
     }
-    
-    static ProgramSource* s_ProgramSourcePtr = nullptr;
-    static std::string s_CurrentCompilingPath = "";
 
     void YosenCompiler::__ys_free_compiled_resources(StackFramePtr faulty_stack_frame)
     {
         // Free the compiled resources on all compiled stack frames
-        if (s_ProgramSourcePtr)
+        if (m_program_source_ptr)
         {
-            for (auto& [stack_frame, bytecode] : s_ProgramSourcePtr->runtime_functions)
+            for (auto& [stack_frame, bytecode] : m_program_source_ptr->runtime_functions)
                 destroy_stack_frame(stack_frame);
 
-            s_ProgramSourcePtr->runtime_functions.clear();
+            m_program_source_ptr->runtime_functions.clear();
         }
 
         // Destroy the faulty stack frame that hasn't compiled yet
@@ -82,12 +81,12 @@ namespace yosen
         {
         case parser::LiteralType::Null:
         {
-            return YosenObject_Null->clone();
+            return YosenObject_Null;
         }
         case parser::LiteralType::Boolean:
         {
             bool bval = (value == "true");
-            return allocate_object<YosenBoolean>(bval);
+            return get_boolean_object(bval);
         }
         case parser::LiteralType::String:
         {
@@ -141,7 +140,7 @@ namespace yosen
         default: throw "Unknown Literal Type";
         }
 
-        return YosenObject_Null->clone();
+        return YosenObject_Null;
     }
 
     static opcodes::opcode_t opcode_from_binary_operator(const std::string_view& op)
@@ -378,6 +377,11 @@ namespace yosen
         }
     }
 
+    void YosenCompiler::init(YosenEnvironment* env)
+    {
+        m_env = env;
+    }
+
     void YosenCompiler::shutdown()
     {
         for (auto& stack_frame : m_allocated_stack_frames)
@@ -442,9 +446,9 @@ namespace yosen
         }
 
         // Then check for a global variable
-        if (YosenEnvironment::get().is_global_variable(var))
+        if (m_env->is_global_variable(var))
         {
-            return { YosenEnvironment::get().get_global_variable_index(var), true };
+            return { m_env->get_global_variable_index(var), true };
         }
 
         // If neither check passes, throw an
@@ -452,7 +456,7 @@ namespace yosen
         __ys_free_compiled_resources(stack_frame);
 
         auto ex_reason = "Undefined variable \"" + var + "\" used";
-        YosenEnvironment::get().throw_exception(CompilerException(ex_reason));
+        m_env->throw_exception(CompilerException(ex_reason));
         return { 0, false };
     }
 
@@ -498,7 +502,7 @@ namespace yosen
         if (ends_with(import_name, ".ys"))
         {
             // Import another file
-            compile_imported_yosen_source_file(import_name, s_CurrentCompilingPath);
+            compile_imported_yosen_source_file(import_name, m_current_compiling_path);
         }
         else
         {
@@ -652,7 +656,7 @@ namespace yosen
         }
     }
 
-    void YosenCompiler::compile_function_call(json11::Json* node_ptr, StackFramePtr stack_frame, bytecode_t& bytecode)
+    void YosenCompiler::compile_function_call(json11::Json* node_ptr, StackFramePtr stack_frame, bytecode_t& bytecode, bool tail_call)
     {
         auto& node = *node_ptr;
 
@@ -704,6 +708,14 @@ namespace yosen
             }
         }
 
+        // Static calls in the tail position replace the caller's frame
+        if (tail_call && !has_caller_flag)
+        {
+            bytecode.push_back(opcodes::TAIL_CALL);
+            bytecode.push_back(static_cast<opcodes::opcode_t>(function_index));
+            return;
+        }
+
         // Create the bytecode for calling the function
         bytecode.push_back(opcodes::CALL);
         bytecode.push_back(static_cast<opcodes::opcode_t>(function_index));
@@ -723,8 +735,8 @@ namespace yosen
         StackFramePtr stack_frame = allocate_stack_frame();
         bytecode_t bytecode;
 
-        // Set the global program source object pointer
-        s_ProgramSourcePtr = &program_source;
+        // Set the current program source object pointer
+        m_program_source_ptr = &program_source;
 
         // Registering the function name
         stack_frame->name = node["name"].string_value();
@@ -735,7 +747,7 @@ namespace yosen
 
         // Allocating a Null object in the variables map (always first)
         stack_frame->var_keys.insert({ "null", 0 });
-        stack_frame->vars.insert({ 0, YosenObject_Null->clone() });
+        stack_frame->vars.insert({ 0, YosenObject_Null });
 
         // Allocating parameters and their variable spaces
         uint32_t param_idx = 0;
@@ -754,7 +766,7 @@ namespace yosen
 
             // Reserving variable space on the stack frame
             stack_frame->var_keys.insert({ param_name, param_key });
-            stack_frame->vars.insert({ param_key, YosenObject_Null->clone() });
+            stack_frame->vars.insert({ param_key, YosenObject_Null });
 
             // Creating bytecode to store the parameter in a variable object
             bytecode.push_back(opcodes::LOAD_PARAM);
@@ -794,6 +806,9 @@ namespace yosen
         // Add the compiled function to the program source object
         program_source.runtime_functions.push_back({ stack_frame, bytecode });
 
+        if (m_record_compiled_functions)
+            m_compiled_functions.push_back({ stack_frame, bytecode });
+
 #if (YOSEN_INTERPRETER_DEBUG_MODE == 1)
         printf("\n");
         debug_print_bytecode(bytecode);
@@ -815,7 +830,7 @@ namespace yosen
             __ys_free_compiled_resources(stack_frame);
 
             auto ex_reason = "Variable \"" + variable_name + "\" already exists";
-            YosenEnvironment::get().throw_exception(CompilerException(ex_reason));
+            m_env->throw_exception(CompilerException(ex_reason));
             return;
         }
 
@@ -826,7 +841,7 @@ namespace yosen
         stack_frame->var_keys.insert({ variable_name, var_key });
 
         // Create an entry in the variables map
-        stack_frame->vars.insert({ var_key, YosenObject_Null->clone() });
+        stack_frame->vars.insert({ var_key, YosenObject_Null });
 
         // Compiling the expression and loading its value
         compile_expression(&value_node, stack_frame, bytecode);
@@ -847,6 +862,15 @@ namespace yosen
             bytecode.push_back(opcodes::LOAD);
             bytecode.push_back(static_cast<opcodes::opcode_t>(0x00));
         }
+        else if (node["value"]["type"].string_value() == parser::ASTNodeType_FunctionCall &&
+                 node["value"]["parent"].is_null())
+        {
+            // The called function stores its result in
+            // the return register and returns by itself.
+            auto call_node = node["value"];
+            compile_function_call(&call_node, stack_frame, bytecode, true);
+            return;
+        }
         else
         {
             auto expression_node = node["value"];
@@ -1108,7 +1132,7 @@ namespace yosen
         auto& class_node = *node_ptr;
         auto class_name = class_node["name"].string_value();
 
-        auto class_builder = YosenEnvironment::get().create_runtime_class_builder(class_name);
+        auto class_builder = m_env->create_runtime_class_builder(class_name);
 
         for (auto body_node : class_node["body"].array_items())
         {
@@ -1126,6 +1150,9 @@ namespace yosen
                     // Compile the function into a separate program source object
                     compile_function_declaration(&body_node, source);
 
+                    // Qualify the name with the class for the tracebacks
+                    source.runtime_functions[0].first->name = class_name + "::" + fn_name;
+
                     // Insert the runtime function into the class builder object
                     class_builder->runtime_functions[fn_name] = source.runtime_functions[0];
                 }
@@ -1143,7 +1170,7 @@ namespace yosen
                 if (value_node["type"].string_value() != parser::ASTNodeType_Literal)
                 {
                     auto ex_reason = "Value of member variable \"" + variable_name + "\" for class \"" + class_name + "\" has to be a literal, not an expression";
-                    YosenEnvironment::get().throw_exception(CompilerException(ex_reason));
+                    m_env->throw_exception(CompilerException(ex_reason));
                     return;
                 }
 
@@ -1151,7 +1178,7 @@ namespace yosen
                 if (class_builder->member_variables.find(variable_name) != class_builder->member_variables.end())
                 {
                     auto ex_reason = "Member variable \"" + variable_name + "\" for class \"" + class_name + "\" already exists";
-                    YosenEnvironment::get().throw_exception(CompilerException(ex_reason));
+                    m_env->throw_exception(CompilerException(ex_reason));
                     return;
                 }
 
@@ -1252,7 +1279,7 @@ namespace yosen
 		{
 			if (obj) free_object(obj);
 
-			stack_frame->vars[key] = YosenObject_Null->clone();
+			stack_frame->vars[key] = YosenObject_Null;
 		}
 
         // Deallocate disposed objects
@@ -1278,46 +1305,175 @@ namespace yosen
         stack_frame->params.clear();
     }
 
+    std::string YosenCompiler::get_import_file_path(const std::string& import_name, const std::string& current_path)
+    {
+        if (current_path.empty())
+            return import_name;
+
+        return current_path + "/" + import_name;
+    }
+
     void YosenCompiler::compile_imported_yosen_source_file(const std::string& import_name, const std::string& current_path)
     {
-        std::string file_path = import_name;
-        if (!current_path.empty())
-            file_path = current_path + "/" + import_name;
+        auto file_path = get_import_file_path(import_name, current_path);
 
         if (import_name.empty() || !std::filesystem::is_regular_file(file_path))
         {
             auto ex_reason = "Can't find imported source file \"" + file_path + "\"";
-            YosenEnvironment::get().throw_exception(CompilerException(ex_reason));
+            m_env->throw_exception(CompilerException(ex_reason));
             return;
         }
 
-        std::ifstream stream(file_path);
-        std::stringstream source_code_buffer;
-        source_code_buffer << stream.rdbuf();
+        // Each source file gets compiled only once no matter how many
+        // files import it, this also prevents circular imports from recursing.
+        auto canonical_path = std::filesystem::weakly_canonical(file_path).string();
+        if (m_compiled_source_files.find(canonical_path) != m_compiled_source_files.end())
+            return;
+
+        m_compiled_source_files.insert(canonical_path);
 
-        auto source_code = source_code_buffer.str();
+        auto source_directory = std::filesystem::path(file_path).parent_path().string();
+        ProgramSource program_source;
+
+        // Use the AST if the file was already parsed ahead of time
+        auto parsed_it = m_parsed_source_files.find(canonical_path);
+        if (parsed_it != m_parsed_source_files.end() && parsed_it->second)
+        {
+            auto ast = parsed_it->second;
+            m_parsed_source_files.erase(parsed_it);
 
-        auto program_source = compile_source(source_code, std::filesystem::path(file_path).parent_path().string());
+            program_source = compile_program_ast(*ast, source_directory);
+        }
+        else
+        {
+            auto source_code = read_source_file(file_path);
+            program_source = compile_source(source_code, source_directory);
+        }
 
         // Register all the functions in the yosen environment
         for (auto& fn : program_source.runtime_functions)
         {
             auto& stack_frame = fn.first;
             m_allocated_stack_frames.push_back(stack_frame);
-            YosenEnvironment::get().register_static_runtime_function(stack_frame->name, fn);
+            m_env->register_static_runtime_function(stack_frame->name, fn);
         }
 
         // Reset the current compiling path
-        s_CurrentCompilingPath = current_path;
+        m_current_compiling_path = current_path;
     }
 
-    ProgramSource YosenCompiler::compile_source(std::string& source, const std::string& source_path)
+    std::string YosenCompiler::read_source_file(const std::string& file_path)
     {
-        ProgramSource program_source;
-        s_CurrentCompilingPath = source_path;
+        std::ifstream stream(file_path);
+        std::stringstream source_code_buffer;
+        source_code_buffer << stream.rdbuf();
+
+        return source_code_buffer.str();
+    }
+
+    void YosenCompiler::collect_imported_source_files(
+        json11::Json& ast,
+        const std::string& source_path,
+        std::vector<std::pair<std::string, std::string>>& imported_files
+    )
+    {
+        for (auto& node : ast.array_items())
+        {
+            if (node["type"].string_value() != parser::ASTNodeType_Import)
+                continue;
 
+            auto& import_name = node["name"].string_value();
+            if (!ends_with(import_name, ".ys"))
+                continue;
+
+            auto file_path = get_import_file_path(import_name, source_path);
+            if (!std::filesystem::is_regular_file(file_path))
+                continue;
+
+            auto canonical_path = std::filesystem::weakly_canonical(file_path).string();
+
+            // Skip files that are already parsed, scheduled or compiled
+            if (m_parsed_source_files.find(canonical_path) != m_parsed_source_files.end() ||
+                m_compiled_source_files.find(canonical_path) != m_compiled_source_files.end())
+                continue;
+
+            m_parsed_source_files[canonical_path] = nullptr;
+            imported_files.push_back({ canonical_path, file_path });
+        }
+    }
+
+    void YosenCompiler::parse_imported_source_files(json11::Json& ast, const std::string& source_path)
+    {
+        // Pairs of canonical path and the relative file path
+        std::vector<std::pair<std::string, std::string>> pending_files;
+        collect_imported_source_files(ast, source_path, pending_files);
+
+        // Each level of the import graph is parsed in parallel,
+        // the imports discovered in it form the next level.
+        while (!pending_files.empty())
+        {
+            std::vector<std::shared_ptr<json11::Json>> parsed_asts(pending_files.size());
+            std::atomic<size_t> next_file_index = 0;
+
+            auto parse_worker = [&]() {
+                // Parser errors are reported to the compiler's environment
+                YosenEnvironmentScope env_scope(m_env);
+
+                parser::Parser parser;
+
+                for (size_t i = next_file_index++; i < pending_files.size(); i = next_file_index++)
+                {
+                    auto source_code = read_source_file(pending_files[i].second);
+                    parsed_asts[i] = std::make_shared<json11::Json>(parser.parse_source(source_code));
+                }
+            };
+
+            size_t worker_count = std::min<size_t>(std::thread::hardware_concurrency(), pending_files.size());
+
+            std::vector<std::thread> workers;
+            for (size_t i = 1; i < worker_count; ++i)
+                workers.emplace_back(parse_worker);
+
+            // The calling thread parses files as well
+            parse_worker();
+
+            for (auto& worker : workers)
+                worker.join();
+
+            // Register the parsed ASTs in a deterministic order
+            // and collect the files they import for the next level.
+            std::vector<std::pair<std::string, std::string>> next_files;
+
+            for (size_t i = 0; i < pending_files.size(); ++i)
+            {
+                auto& [canonical_path, file_path] = pending_files[i];
+                m_parsed_source_files[canonical_path] = parsed_asts[i];
+
+                auto source_directory = std::filesystem::path(file_path).parent_path().string();
+                collect_imported_source_files(*parsed_asts[i], source_directory, next_files);
+            }
+
+            pending_files = std::move(next_files);
+        }
+    }
+
+    ProgramSource YosenCompiler::compile_source(std::string& source, const std::string& source_path)
+    {
         parser::Parser parser;
         auto ast = parser.parse_source(source);
+
+        // Parse the whole import graph ahead of time so that the
+        // independent source files get parsed concurrently.
+        parse_imported_source_files(ast, source_path);
+
+        return compile_program_ast(ast, source_path);
+    }
+
+    ProgramSource YosenCompiler::compile_program_ast(json11::Json& ast, const std::string& source_path)
+    {
+        ProgramSource program_source;
+        m_current_compiling_path = source_path;
+
         for (auto node : ast.array_items())
         {
             auto node_type = node["type"].string_value();
@@ -1335,7 +1491,7 @@ namespace yosen
                 else
                 {
                     // Load a native library module
-                    YosenEnvironment::get().load_yosen_module(import_name);   
+                    m_env->load_yosen_module(import_name);   
                 }
             }
             else if (node_type == parser::ASTNodeType_FunctionDeclaration)
@@ -1354,15 +1510,15 @@ namespace yosen
                 if (value_node["type"].string_value() != parser::ASTNodeType_Literal)
                 {
                     auto ex_reason = "Value of a global variable \"" + variable_name + "\" has to be a literal, not an expression";
-                    YosenEnvironment::get().throw_exception(CompilerException(ex_reason));
+                    m_env->throw_exception(CompilerException(ex_reason));
                     return program_source;
                 }
 
                 // Check if the variable exists
-                if (YosenEnvironment::get().is_global_variable(variable_name))
+                if (m_env->is_global_variable(variable_name))
                 {
                     auto ex_reason = "Global variable \"" + variable_name + "\" already exists";
-                    YosenEnvironment::get().throw_exception(CompilerException(ex_reason));
+                    m_env->throw_exception(CompilerException(ex_reason));
                     return program_source;
                 }
 
@@ -1373,7 +1529,7 @@ namespace yosen
                 auto global_var_obj = allocate_literal_object(literal_type, value_node_literal_value);
 
                 // Create a global variable entry
-                YosenEnvironment::get().register_global_variable(variable_name, global_var_obj);
+                m_env->register_global_variable(variable_name, global_var_obj);
             }
         }
 
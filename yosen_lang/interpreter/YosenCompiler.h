@@ -2,6 +2,7 @@
 #include <YosenEnvironment.h>
 #include "opcodes.h"
 #include <stack>
+#include <set>
 
 // Forward declaration
 namespace json11 { class Json; }
@@ -25,12 +26,27 @@ namespace yosen
 		// a complete program source object.
 		ProgramSource compile_source(std::string& source, const std::string& source_path);
 
+		// Compiles the AST of an entire source file into a program source object,
+		// imported source files are compiled but not parsed ahead of time.
+		ProgramSource compile_program_ast(json11::Json& ast, const std::string& source_path);
+
 		// Compiles a single statement
 		bytecode_t compile_single_statement(std::string& source, StackFramePtr stack_frame);
 
+		// Sets the environment that compiled functions,
+		// classes and global variables get registered into.
+		void init(YosenEnvironment* env);
+
 		// Frees all compiled resources
 		void shutdown();
 
+		// Keeps a copy of every function compiled from now on, including
+		// member functions and functions of the imported source files.
+		inline void set_record_compiled_functions(bool record) { m_record_compiled_functions = record; }
+
+		// Returns the recorded functions in the order they were compiled
+		inline const std::vector<ys_runtime_function_t>& get_compiled_functions() const { return m_compiled_functions; }
+
 	private:
 		// Returns the key for the constant defined by the AST node
 		uint32_t get_constant_literal_key(json11::Json* node_ptr, StackFramePtr stack_frame);
@@ -54,8 +70,8 @@ namespace yosen
 		// Compiles a generic expression based on the AST node
 		void compile_expression(json11::Json* node_ptr, StackFramePtr stack_frame, bytecode_t& bytecode);
 
-		// Compiles a function call AST node
-		void compile_function_call(json11::Json* node_ptr, StackFramePtr stack_frame, bytecode_t& bytecode);
+		// Compiles a function call AST node, tail calls are made with TAIL_CALL
+		void compile_function_call(json11::Json* node_ptr, StackFramePtr stack_frame, bytecode_t& bytecode, bool tail_call = false);
 
 		// Compiles a function declaration from the AST
 		void compile_function_declaration(json11::Json* node_ptr, ProgramSource& program_source);
@@ -105,7 +121,27 @@ namespace yosen
 		// Loads a Yosen source file into the running program
 		void compile_imported_yosen_source_file(const std::string& import_name, const std::string& current_path);
 
+		// Returns the path of an imported file relative to the importing file's directory
+		std::string get_import_file_path(const std::string& import_name, const std::string& current_path);
+
+		// Reads the entire contents of a source file
+		std::string read_source_file(const std::string& file_path);
+
+		// Adds the source files imported by the AST that haven't been parsed or compiled yet
+		// to the list as pairs of canonical path and file path, and marks them as scheduled.
+		void collect_imported_source_files(
+			json11::Json& ast,
+			const std::string& source_path,
+			std::vector<std::pair<std::string, std::string>>& imported_files
+		);
+
+		// Discovers the whole import graph of the AST and parses all
+		// the imported source files on multiple threads ahead of compilation.
+		void parse_imported_source_files(json11::Json& ast, const std::string& source_path);
+
 	private:
+		YosenEnvironment* m_env = nullptr;
+
 		// Each loop gets its own list of indices to be replaced.
 		// If a break statement occurs, the instruction pointer should
 		// jump to the end of the loop.
@@ -114,5 +150,19 @@ namespace yosen
 	private:
 		// List of all allocated stack frames that were imported
 		std::vector<StackFramePtr> m_allocated_stack_frames;
+
+		// Canonical paths of all the source files that were already compiled
+		std::set<std::string> m_compiled_source_files;
+
+		// ASTs of the imported source files parsed ahead of compilation
+		std::map<std::string, std::shared_ptr<json11::Json>> m_parsed_source_files;
+
+		// Program source and source directory currently being compiled
+		ProgramSource* m_program_source_ptr = nullptr;
+		std::string m_current_compiling_path;
+
+		// Functions recorded for the disassembler
+		bool m_record_compiled_functions = false;
+		std::vector<ys_runtime_function_t> m_compiled_functions;
 	};
 }
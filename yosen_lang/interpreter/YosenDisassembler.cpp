@@ -0,0 +1,216 @@
+#include "YosenDisassembler.h"
+#include <set>
+
+namespace yosen
+{
+    static std::string format_constant(YosenObject* obj)
+    {
+        if (!obj)
+            return "<null>";
+
+        if (!obj->is<YosenString>())
+            return obj->to_string();
+
+        std::string result = "\"";
+        for (auto c : obj->as<YosenString>()->value)
+        {
+            switch (c)
+            {
+            case '\n': result += "\\n"; break;
+            case '\t': result += "\\t"; break;
+            case '"': result += "\\\""; break;
+            default: result += c; break;
+            }
+        }
+
+        result += "\"";
+        return result;
+    }
+
+    static const char* get_register_name(opcodes::opcode_t reg)
+    {
+        switch (reg)
+        {
+        case 0x01: return "allocated object register";
+        case 0x02: return "return register";
+        case 0x03: return "temporary object register";
+        default: return "unknown register";
+        }
+    }
+
+    // Returns the name at the index or a placeholder if the index is out of range
+    static std::string get_name_at(const std::vector<std::string>& names, size_t idx)
+    {
+        return idx < names.size() ? names[idx] : "<invalid index>";
+    }
+
+    std::string YosenDisassembler::describe_operand(const StackFramePtr& stack_frame, const bytecode_t& bytecode, size_t offset)
+    {
+        auto op = bytecode[offset];
+        auto operand = bytecode[offset + 1];
+
+        switch (op)
+        {
+        case opcodes::LOAD:
+        case opcodes::STORE:
+        {
+            for (auto& [name, key] : stack_frame->var_keys)
+                if (key == operand)
+                    return name;
+
+            return "<unknown variable>";
+        }
+        case opcodes::LOAD_CONST:
+        {
+            auto it = stack_frame->constants.find(operand);
+            return (it != stack_frame->constants.end()) ? format_constant(it->second) : "<unknown constant>";
+        }
+        case opcodes::LOAD_PARAM:
+            return operand < stack_frame->params.size() ? stack_frame->params[operand].first : "<invalid index>";
+        case opcodes::LOAD_MEMBER:
+        case opcodes::STORE_MEMBER:
+            return "." + get_name_at(stack_frame->member_variable_names, operand);
+        case opcodes::LOAD_GLOBAL:
+        case opcodes::STORE_GLOBAL:
+        {
+            auto name = m_env->get_global_variable_name(operand);
+            return name.empty() ? "<unknown global>" : "global " + name;
+        }
+        case opcodes::CALL:
+        {
+            auto name = get_name_at(stack_frame->function_names, operand);
+            return bytecode[offset + 2] ? name + " (member)" : name;
+        }
+        case opcodes::TAIL_CALL:
+            return get_name_at(stack_frame->function_names, operand);
+        case opcodes::REG_LOAD:
+        case opcodes::REG_STORE:
+            return get_register_name(operand);
+        case opcodes::ALLOC_OBJECT:
+            return "new " + get_name_at(stack_frame->class_names, operand);
+        case opcodes::IMPORT_LIB:
+            return get_name_at(stack_frame->imported_library_names, operand);
+        case opcodes::JMP:
+        case opcodes::JMP_IF_FALSE:
+            return "-> " + std::to_string(operand);
+        case opcodes::SET_RUNTIME_FLAG:
+            return operand == 0x01 ? "sequence function call" : "null";
+        default:
+            return "";
+        }
+    }
+
+    void YosenDisassembler::disassemble_function(const ys_runtime_function_t& fn)
+    {
+        auto& [stack_frame, bytecode] = fn;
+
+        FunctionSummary summary;
+        summary.name = stack_frame->name;
+        summary.bytecode_bytes = bytecode.size() * sizeof(opcodes::opcode_t);
+        summary.constants = stack_frame->constants.size();
+        summary.variables = stack_frame->var_keys.size();
+
+        // Instructions that are jumped to get marked in the listing
+        std::set<size_t> jump_targets;
+        for (size_t offset = 0; offset < bytecode.size(); offset += 1 + opcodes::get_opcode_operand_count(bytecode[offset]))
+        {
+            auto op = bytecode[offset];
+            if ((op == opcodes::JMP || op == opcodes::JMP_IF_FALSE) && offset + 1 < bytecode.size())
+                jump_targets.insert(bytecode[offset + 1]);
+        }
+
+        fprintf(m_output, "Function %s(", stack_frame->name.c_str());
+        for (size_t i = 0; i < stack_frame->params.size(); ++i)
+            fprintf(m_output, "%s%s", i ? ", " : "", stack_frame->params[i].first.c_str());
+
+        fprintf(m_output, ")\n");
+
+        if (!stack_frame->constants.empty())
+        {
+            fprintf(m_output, "  constants:\n");
+
+            for (auto& [key, obj] : stack_frame->constants)
+                fprintf(m_output, "    0x%-6x %s\n", key, format_constant(obj).c_str());
+        }
+
+        fprintf(m_output, "  code:\n");
+
+        size_t offset = 0;
+        while (offset < bytecode.size())
+        {
+            auto op = bytecode[offset];
+            auto operand_count = opcodes::get_opcode_operand_count(op);
+            auto name = opcodes::get_opcode_name(op);
+
+            fprintf(m_output, "  %2s %6zu  ", jump_targets.count(offset) ? ">>" : "", offset);
+
+            if (!name)
+            {
+                fprintf(m_output, "0x%x (unknown opcode)\n", op);
+                ++offset;
+                ++summary.instructions;
+                continue;
+            }
+
+            if (offset + operand_count >= bytecode.size())
+            {
+                fprintf(m_output, "%-18s <truncated>\n", name);
+                break;
+            }
+
+            std::string operands;
+            for (unsigned int i = 1; i <= operand_count; ++i)
+            {
+                char operand_str[16];
+                snprintf(operand_str, sizeof(operand_str), "%s0x%x", (i > 1) ? " " : "", bytecode[offset + i]);
+                operands += operand_str;
+            }
+
+            auto description = operand_count ? describe_operand(stack_frame, bytecode, offset) : "";
+
+            if (!operand_count)
+                fprintf(m_output, "%s\n", name);
+            else if (description.empty())
+                fprintf(m_output, "%-18s %s\n", name, operands.c_str());
+            else
+                fprintf(m_output, "%-18s %-12s %s\n", name, operands.c_str(), description.c_str());
+
+            offset += 1 + operand_count;
+            ++summary.instructions;
+        }
+
+        fprintf(m_output, "\n");
+        m_summaries.push_back(summary);
+    }
+
+    void YosenDisassembler::print_summary()
+    {
+        FunctionSummary total;
+
+        fprintf(m_output, "%-32s %12s %10s %10s %10s\n", "function", "instructions", "bytes", "constants", "variables");
+
+        for (auto& summary : m_summaries)
+        {
+            fprintf(m_output, "%-32s %12zu %10zu %10zu %10zu\n",
+                summary.name.c_str(),
+                summary.instructions,
+                summary.bytecode_bytes,
+                summary.constants,
+                summary.variables
+            );
+
+            total.instructions += summary.instructions;
+            total.bytecode_bytes += summary.bytecode_bytes;
+            total.constants += summary.constants;
+            total.variables += summary.variables;
+        }
+
+        fprintf(m_output, "%-32s %12zu %10zu %10zu %10zu\n",
+            "total",
+            total.instructions,
+            total.bytecode_bytes,
+            total.constants,
+            total.variables
+        );
+    }
+}
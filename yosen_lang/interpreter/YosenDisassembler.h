@@ -0,0 +1,40 @@
+#pragma once
+#include "YosenCompiler.h"
+#include <cstdio>
+
+namespace yosen
+{
+	// Prints compiled functions as readable instructions with their operands resolved
+	// to the constants, variables, functions and member names of the stack frame.
+	class YosenDisassembler
+	{
+	public:
+		YosenDisassembler(YosenEnvironment* env, FILE* output = stdout)
+			: m_env(env), m_output(output) {}
+
+		// Prints the constant pool and the instructions of the function
+		void disassemble_function(const ys_runtime_function_t& fn);
+
+		// Prints the instruction counts and constant pool sizes of all the disassembled functions
+		void print_summary();
+
+	private:
+		YosenEnvironment* m_env;
+		FILE* m_output;
+
+		struct FunctionSummary
+		{
+			std::string name;
+			size_t instructions = 0;
+			size_t bytecode_bytes = 0;
+			size_t constants = 0;
+			size_t variables = 0;
+		};
+
+		std::vector<FunctionSummary> m_summaries;
+
+	private:
+		// Returns a description of the operand of the instruction at the given offset
+		std::string describe_operand(const StackFramePtr& stack_frame, const bytecode_t& bytecode, size_t offset);
+	};
+}
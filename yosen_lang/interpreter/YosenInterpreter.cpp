@@ -1,4 +1,5 @@
 #include "YosenInterpreter.h"
+#include "YosenDisassembler.h"
 #include <iostream>
 
 namespace yosen::utils
@@ -23,12 +24,17 @@ namespace yosen::utils
 
 namespace yosen
 {
-    void YosenInterpreter::init()
+    void YosenInterpreter::init(YosenEnvironment* env)
 	{
-		// Initialize the current environment
-		YosenEnvironment::init();
+		// Use the default environment if no isolated environment is given
+		if (!env)
+		{
+			YosenEnvironment::init();
+			env = &YosenEnvironment::get();
+		}
 
-		m_env = &YosenEnvironment::get();
+		m_env = env;
+		m_compiler.init(m_env);
 
         // Register keyboard interrupt handler
         utils::set_keyboard_interrupt_handler([this]() {
@@ -40,6 +46,14 @@ namespace yosen
             main_exception_handler(ex);
         });
 
+        // Allow native code to call runtime functions from any thread
+        m_env->register_execution_context_factory([env = m_env]() -> std::unique_ptr<YosenExecutionContext> {
+            auto context = std::make_unique<YosenInterpreter>();
+            context->init_execution_context(env);
+
+            return context;
+        });
+
 #if (YOSEN_INTERPRETER_DEBUG_MODE == 1)
 		utils::log_colored(
 			utils::ConsoleColor::Green,
@@ -48,8 +62,23 @@ namespace yosen
 #endif
 	}
 	
+    void YosenInterpreter::init_execution_context(YosenEnvironment* env)
+    {
+        m_env = env;
+        m_compiler.init(m_env);
+
+        m_execution_context_mode = true;
+    }
+
 	void YosenInterpreter::shutdown()
 	{
+        YosenEnvironmentScope env_scope(m_env);
+
+#ifdef YOSEN_ENABLE_STATS
+        if (m_stats)
+            m_stats->print_summary();
+#endif
+
         // Destroy compiler resources
         m_compiler.shutdown();
 
@@ -62,10 +91,33 @@ namespace yosen
             destroy_stack_frame(stack_frame);
         }
 
+        // Destroy all objects on the operations stack and in the registers
+        free_register_objects();
+
+        // Destroy the entry point argument object if it was used
+        if (m_entry_point_args)
+            free_object(m_entry_point_args);
+
+		// Shutdown the environment
+		m_env->shutdown();
+
+#if (YOSEN_INTERPRETER_DEBUG_MODE == 1)
+		utils::log_colored(
+			utils::ConsoleColor::Green,
+			"[*] Interpreter Shutdown, total objects left allocated is {%zi}, exiting...\n",
+			__yosen_get_total_allocated_objects()
+		);
+#endif
+	}
+
+    void YosenInterpreter::free_register_objects()
+    {
         // Destroy all objects on the operations stack
         for (auto& obj : m_operation_stack_objects)
             free_object(obj);
 
+        m_operation_stack_objects.clear();
+
         // If the return register is not empty, deallocate the existing object
         if (m_registers[RegisterType::ReturnRegister] != nullptr)
         {
@@ -87,21 +139,144 @@ namespace yosen
             m_registers[RegisterType::TemporaryObjectRegister] = nullptr;
         }
 
-        // Destroy the entry point argument object if it was used
-        if (m_entry_point_args)
-            free_object(m_entry_point_args);
+        // Destroy the copies of the global variables made by tasks
+        for (auto& [key, obj] : m_global_copies)
+            free_object(obj);
 
-		// Shutdown the environment
-		m_env->shutdown();
+        for (auto& obj : m_stale_global_copies)
+            free_object(obj);
 
-#if (YOSEN_INTERPRETER_DEBUG_MODE == 1)
-		utils::log_colored(
-			utils::ConsoleColor::Green,
-			"[*] Interpreter Shutdown, total objects left allocated is {%zi}, exiting...\n",
-			__yosen_get_total_allocated_objects()
-		);
+        m_global_copies.clear();
+        m_stale_global_copies.clear();
+    }
+
+    YosenObject*& YosenInterpreter::load_global_copy(uint32_t key)
+    {
+        // Storing any global variable makes all the copies out of date
+        auto version = m_env->get_global_variables_version();
+        if (version != m_global_copies_version)
+        {
+            for (auto& [copy_key, obj] : m_global_copies)
+                m_stale_global_copies.push_back(obj);
+
+            m_global_copies.clear();
+            m_global_copies_version = version;
+        }
+
+        auto& copy = m_global_copies[key];
+        if (!copy)
+            copy = m_env->clone_global_variable(key);
+
+        return copy;
+    }
+
+    YosenObject* YosenInterpreter::call_function(const std::string& name, YosenArgs args)
+    {
+        YosenEnvironmentScope env_scope(m_env);
+
+        // Exceptions are kept for the caller instead of reaching the environment's handlers
+        m_execution_context_exception.reset();
+
+        exception_handler_t exception_handler = [this](const YosenException& ex) {
+            if (!m_execution_context_exception)
+                m_execution_context_exception = ex;
+        };
+
+        YosenExceptionHandlerScope exception_handler_scope(&exception_handler);
+
+        // Native functions don't take ownership of the arguments
+        if (m_env->is_static_native_function(name))
+        {
+            auto fn = m_env->get_static_native_function(name);
+            auto return_val = fn(args);
+
+            if (m_execution_context_exception)
+            {
+                if (return_val)
+                    free_object(return_val);
+
+                return nullptr;
+            }
+
+            return return_val ? return_val : YosenObject_Null;
+        }
+
+        if (!m_env->is_static_runtime_function(name))
+        {
+            auto ex_reason = "Static function \"" + name + "\" not found";
+            m_env->throw_exception(RuntimeException(ex_reason));
+            return nullptr;
+        }
+
+        auto fn = m_env->get_static_runtime_function(name);
+
+        auto fn_stack_frame = fn.first->clone();
+        auto& fn_bytecode = fn.second;
+
+        if (fn_stack_frame->params.size() != args.size())
+        {
+            auto ex_reason = "function \"" + name + "\" expected " +
+                std::to_string(fn_stack_frame->params.size()) +
+                " arguments, received " + std::to_string(args.size()) +
+                " arguments";
+
+            // Destroy the stack frame since it's a clone
+            destroy_stack_frame(fn_stack_frame);
+
+            m_env->throw_exception(RuntimeException(ex_reason));
+            return nullptr;
+        }
+
+        // Copy the arguments into the function's stack frame
+        for (size_t i = 0; i < args.size(); ++i)
+            fn_stack_frame->params[i].second = args[i]->clone();
+
+        m_call_stack.push_back({ CallStackEntryType::Function, &name });
+
+#ifdef YOSEN_ENABLE_STATS
+        if (m_stats)
+            m_stats->record_function_call(m_call_stack.back());
 #endif
-	}
+
+        // Create an empty parameter stack to be used by the function for future functions
+        m_parameter_stacks.push({});
+
+        // Run the user function (return register will automatically be updated
+        execute_bytecode(fn_stack_frame, fn_bytecode);
+
+        // Deallocate the user function's stack frame
+        deallocate_stack_frame(fn_stack_frame);
+
+        // Destroy the stack frame since it's a clone
+        destroy_stack_frame(fn_stack_frame);
+
+        // Pop the functions's parameter stack
+        m_parameter_stacks.pop();
+        m_call_stack.pop_back();
+
+        // Move the return value out of the return register
+        auto return_val = m_registers[RegisterType::ReturnRegister];
+        m_registers[RegisterType::ReturnRegister] = nullptr;
+
+        // Execution contexts don't keep any objects between calls
+        if (m_execution_context_mode)
+            free_register_objects();
+
+        if (m_execution_context_exception)
+        {
+            if (return_val)
+                free_object(return_val);
+
+            return nullptr;
+        }
+
+        return return_val ? return_val : YosenObject_Null;
+    }
+
+    const YosenException* YosenInterpreter::get_last_exception() const
+    {
+        return m_execution_context_exception ? &*m_execution_context_exception : nullptr;
+    }
 
     void YosenInterpreter::main_exception_handler(const YosenException& ex)
     {
@@ -119,6 +294,9 @@ namespace yosen
             return;
         }
 
+        if (m_exit_handler)
+            m_exit_handler();
+
         shutdown();
         exit(1);
     }
@@ -130,8 +308,12 @@ namespace yosen
             "Callstack:\n"
         );
         
-        for (auto& name : m_call_stack)
+        std::string name;
+        for (auto& entry : m_call_stack)
         {
+            name.clear();
+            entry.append_name(name);
+
             utils::log_colored(
                 utils::ConsoleColor::Yellow,
                 "<>\t%s\n",
@@ -142,6 +324,9 @@ namespace yosen
 
     void YosenInterpreter::run_source(std::string& source, const std::vector<std::string>& cmd_arguments)
     {
+        // Natives and primitives executed by this interpreter use its environment
+        YosenEnvironmentScope env_scope(m_env);
+
         // Compile the source code
         auto source_directory = std::filesystem::path(cmd_arguments.at(0)).parent_path().string();
         auto program_source = m_compiler.compile_source(source, source_directory);
@@ -158,17 +343,15 @@ namespace yosen
         }
 
         // Get the entry point
-        std::string entry_point_name = "main";
-
-        if (!m_env->is_static_runtime_function(entry_point_name))
+        if (!m_env->is_static_runtime_function(m_entry_point_name))
         {
             m_env->throw_exception(
-                RuntimeException("Could not find entry point \"" + entry_point_name + "\"")
+                RuntimeException("Could not find entry point \"" + m_entry_point_name + "\"")
             );
         }
 
         // Get the entry point function stack frame
-        auto [stack_frame, bytecode] = m_env->get_static_runtime_function(entry_point_name);
+        auto [stack_frame, bytecode] = m_env->get_static_runtime_function(m_entry_point_name);
 
         // Prepare the args parameter value
         if (stack_frame->params.size())
@@ -185,6 +368,34 @@ namespace yosen
         execute_bytecode(stack_frame, bytecode);
     }
 
+    void YosenInterpreter::disassemble_source(std::string& source, const std::vector<std::string>& cmd_arguments)
+    {
+        YosenEnvironmentScope env_scope(m_env);
+
+        // Member functions and imported functions aren't
+        // part of the program source, the compiler records them all.
+        m_compiler.set_record_compiled_functions(true);
+
+        auto source_directory = std::filesystem::path(cmd_arguments.at(0)).parent_path().string();
+        auto program_source = m_compiler.compile_source(source, source_directory);
+
+        m_compiler.set_record_compiled_functions(false);
+
+        // Stack frames get freed along with the interpreter's resources,
+        // which expects the parameter stack that run_source would create.
+        m_parameter_stacks.push({});
+
+        for (auto& fn : program_source.runtime_functions)
+            m_allocated_stack_frames.push_back(fn.first);
+
+        YosenDisassembler disassembler(m_env);
+
+        for (auto& fn : m_compiler.get_compiled_functions())
+            disassembler.disassemble_function(fn);
+
+        disassembler.print_summary();
+    }
+
     std::string YosenInterpreter::read_block_source(const std::string& header, const std::string& tab_space)
     {
         std::string result = header + "\n";
@@ -211,6 +422,8 @@ namespace yosen
 
 	void YosenInterpreter::run_interactive_shell()
 	{
+        YosenEnvironmentScope env_scope(m_env);
+
         // Tell the interpreter that it is
         // now running in the interactive console mode.
         m_interactive_mode = true;
@@ -268,7 +481,7 @@ namespace yosen
 		{
 			if (obj) free_object(obj);
 
-			stack_frame->vars[key] = YosenObject_Null->clone();
+			stack_frame->vars[key] = YosenObject_Null;
 		}
 
 		// Deallocate pushed variables
@@ -297,10 +510,31 @@ namespace yosen
 		stack_frame->vars.clear();
 		stack_frame->params.clear();
 	}
+
+	void YosenInterpreter::free_parameter_stack(std::vector<YosenObject*>& parameter_stack)
+	{
+		for (auto& obj : parameter_stack)
+			free_object(obj);
+
+		parameter_stack.clear();
+	}
 	
 	void YosenInterpreter::execute_bytecode(StackFramePtr stack_frame, bytecode_t& bytecode)
 	{
-        for (size_t i = 0; i < bytecode.size();)
+        // Frames below the entry frame belong to the native callers
+        size_t base_depth = m_call_frames.size();
+
+        CallFrame entry_frame;
+        entry_frame.type = CallFrameType::Entry;
+        entry_frame.stack_frame = stack_frame;
+        entry_frame.ops = bytecode.data();
+        entry_frame.op_count = bytecode.size();
+
+        m_call_frames.push_back(std::move(entry_frame));
+
+        // Calls made by the executed instructions push their frames onto
+        // the frame stack and continue in the same loop instead of recursing.
+        while (m_call_frames.size() > base_depth)
         {
             // If an exception occurs in the interactive console mode,
             // then the shell should abandon processing the current statement.
@@ -308,14 +542,153 @@ namespace yosen
                 m_interactive_shell_exception_occured)
             {
                 m_interactive_shell_exception_occured = false;
+
+                while (m_call_frames.size() > base_depth)
+                    pop_call_frame();
+
                 break;
             }
 
-            auto incr = execute_instruction(stack_frame, &bytecode[i], i, bytecode.size());
-            i += incr;
+            // Calls made through an execution context stop at the first exception
+            if (m_execution_context_exception)
+            {
+                while (m_call_frames.size() > base_depth)
+                    pop_call_frame();
+
+                break;
+            }
+
+            if (m_profiler && m_profiler->has_pending_samples())
+                record_profiler_sample();
+
+            size_t frame_idx = m_call_frames.size() - 1;
+            auto& frame = m_call_frames[frame_idx];
+
+            // Returning from the function
+            if (frame.ip >= frame.op_count)
+            {
+                pop_call_frame();
+                continue;
+            }
+
+            // The instruction may push new frames, so the
+            // current frame is accessed by its index after.
+            size_t ip = frame.ip;
+
+#ifdef YOSEN_ENABLE_STATS
+            auto opcode = frame.ops[ip];
+
+            YosenInterpreterStats::InstructionStart stats_start;
+            if (m_stats)
+                stats_start = m_stats->begin_instruction();
+#endif
+
+            auto incr = execute_instruction(frame.stack_frame, frame.ops + ip, ip, frame.op_count);
+
+#ifdef YOSEN_ENABLE_STATS
+            if (m_stats)
+                m_stats->end_instruction(opcode, stats_start);
+#endif
+
+            m_call_frames[frame_idx].ip = ip + incr;
         }
 	}
 
+    bool YosenInterpreter::check_recursion_limit(std::vector<YosenObject*>& parameter_stack)
+    {
+        if (m_call_frames.size() < m_recursion_limit)
+            return true;
+
+        // Deallocate the parameters
+        free_parameter_stack(parameter_stack);
+
+        auto ex_reason = "Maximum recursion depth of " + std::to_string(m_recursion_limit) + " exceeded";
+        m_env->throw_exception(RuntimeException(ex_reason));
+        return false;
+    }
+
+    void YosenInterpreter::push_call_frame(CallFrameType type, StackFramePtr stack_frame, bytecode_t&& bytecode)
+    {
+        CallFrame frame;
+        frame.type = type;
+        frame.stack_frame = stack_frame;
+
+        // The operations pointer stays valid when the frame is moved
+        frame.bytecode = std::move(bytecode);
+        frame.ops = frame.bytecode.data();
+        frame.op_count = frame.bytecode.size();
+
+        m_call_frames.push_back(std::move(frame));
+
+        // Create an empty parameter stack to be used by the function for future functions
+        m_parameter_stacks.push({});
+    }
+
+    void YosenInterpreter::pop_call_frame()
+    {
+        auto frame = std::move(m_call_frames.back());
+        m_call_frames.pop_back();
+
+        // Entry frames are cleaned up by their native callers
+        if (frame.type == CallFrameType::Entry)
+            return;
+
+        auto& fn_stack_frame = frame.stack_frame;
+
+        // Get the constructed instance object from the reference
+        YosenObject* instance = nullptr;
+        if (frame.type == CallFrameType::Constructor)
+            instance = fn_stack_frame->params[0].second->as<YosenReference>()->obj;
+
+        // Deallocate the user function's stack frame
+        deallocate_stack_frame(fn_stack_frame);
+
+        // Destroy the stack frame since it's a clone
+        destroy_stack_frame(fn_stack_frame);
+
+        // Pop the functions's parameter stack
+        m_parameter_stacks.pop();
+
+        // Pop the function off the call stack
+        m_call_stack.pop_back();
+
+        // Deallocate the caller's parameters that were not moved into the stack frame
+        free_parameter_stack(m_parameter_stacks.top());
+
+        if (frame.type == CallFrameType::Constructor)
+            store_allocated_object(instance);
+    }
+
+    bool YosenInterpreter::enable_stats()
+    {
+#ifdef YOSEN_ENABLE_STATS
+        if (!m_stats)
+            m_stats = std::make_unique<YosenInterpreterStats>();
+
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void YosenInterpreter::record_profiler_sample()
+    {
+        m_profiler->record_sample(m_entry_point_name, m_call_stack);
+    }
+
+    void YosenInterpreter::store_allocated_object(YosenObject* instance)
+    {
+        // Retrieve the original object
+        auto original_object = m_registers[RegisterType::AllocatedObjectRegister];
+
+        // Copy the object into the register
+        m_registers[RegisterType::AllocatedObjectRegister] = instance;
+
+        // Free the original object
+        if (original_object)
+            free_object(original_object);
+    }
+
 	size_t YosenInterpreter::execute_instruction(StackFramePtr stack_frame, opcodes::opcode_t* ops, size_t& current_instruction, size_t instruction_count)
 	{
         size_t opcount = 1;
@@ -398,7 +771,7 @@ namespace yosen
                 free_object(original_object);
 
             // Load the member object into LLOref
-            LLOref = &static_cast<YosenReference*>(m_registers[RegisterType::TemporaryObjectRegister])->obj;
+            LLOref = &m_registers[RegisterType::TemporaryObjectRegister]->as<YosenReference>()->obj;
 
             break;
         }
@@ -437,6 +810,13 @@ namespace yosen
             auto operand = ops[1];
             opcount = 2;
 
+            // Tasks on the task pool work with copies of the global variables
+            if (m_execution_context_mode && YosenTaskPool::is_running_task())
+            {
+                LLOref = &load_global_copy(operand);
+                break;
+            }
+
             LLOref = &m_env->get_global_variable(operand);
             break;
         }
@@ -446,15 +826,18 @@ namespace yosen
             auto operand = ops[1];
             opcount = 2;
 
-            // Retrieve the original object
-            auto original_object = m_env->get_global_variable(operand);
-
-            // Assign the new object
-            m_env->set_global_variable(operand, (*LLOref)->clone());
+            // Only the threads that own the environment may replace global variables
+            if (m_execution_context_mode && YosenTaskPool::is_running_task())
+            {
+                auto ex_reason = "Global variable \"" + m_env->get_global_variable_name(operand) +
+                    "\" cannot be assigned from a task running on the task pool";
 
-            // Free the original object
-            free_object(original_object);
+                m_env->throw_exception(RuntimeException(ex_reason));
+                return 0;
+            }
 
+            // Copies the object and frees the original one
+            m_env->store_global_variable(operand, *LLOref);
             break;
         }
         case opcodes::REG_LOAD:
@@ -602,7 +985,7 @@ namespace yosen
             auto operand = ops[1];
             opcount = 2;
 
-            if (!LLOref || strcmp((*LLOref)->runtime_name(), "Boolean") != 0)
+            if (!LLOref || !(*LLOref)->is<YosenBoolean>())
             {
                 auto ex_reason = "conditional expression is not a boolean";
                 m_env->throw_exception(RuntimeException(ex_reason));
@@ -610,7 +993,7 @@ namespace yosen
             }
 
             // Get the boolean value of the loaded conditional expression
-            auto value = static_cast<YosenBoolean*>((*LLOref))->value;
+            auto value = (*LLOref)->as<YosenBoolean>()->value;
 
             if (!value)
             {
@@ -642,7 +1025,7 @@ namespace yosen
             auto operand = ops[1];
             opcount = 2;
 
-            auto class_name = stack_frame->class_names[operand];
+            auto& class_name = stack_frame->class_names[operand];
 
             if (!m_env->is_class_name(class_name))
             {
@@ -655,20 +1038,29 @@ namespace yosen
             auto& parameter_stack = m_parameter_stacks.top();
             auto param_count = parameter_stack.size();
 
-            // Reverse the param stack
-            std::reverse(parameter_stack.begin(), parameter_stack.end());
-
-            YosenTuple* param_pack = allocate_object<YosenTuple>(parameter_stack);
-
-            // Instantiate the class
-            auto instance = m_env->construct_class_instance(class_name, param_pack);
+            // Instantiate the class, the builder gets
+            // a view directly over the parameter stack.
+            auto instance = m_env->construct_class_instance(
+                class_name, YosenArgs(parameter_stack.data(), param_count)
+            );
 
             // In case of a user-defined class, there may be a constructor,
             // if it exists, call it.
             if (instance->has_member_runtime_function(class_name))
             {
+                if (!check_recursion_limit(parameter_stack))
+                {
+                    free_object(instance);
+                    return 0;
+                }
+
                 // Add the constructor to the call stack
-                m_call_stack.push_back(class_name + "::constructor");
+                m_call_stack.push_back({ CallStackEntryType::Constructor, &class_name });
+
+#ifdef YOSEN_ENABLE_STATS
+                if (m_stats)
+                    m_stats->record_function_call(m_call_stack.back());
+#endif
 
                 auto fn = instance->get_member_runtime_function(class_name);
 
@@ -692,11 +1084,8 @@ namespace yosen
                         // Destroy the stack frame since it's a clone
                         destroy_stack_frame(fn_stack_frame);
 
-                        // Deallocate the parameter pack object
-                        free_object(param_pack);
-
-                        // Clear the parameter stack
-                        parameter_stack.clear();
+                        // Deallocate the parameters
+                        free_parameter_stack(parameter_stack);
 
                         // Destroy the allocated instance
                         free_object(instance);
@@ -708,67 +1097,115 @@ namespace yosen
                     // Assign the caller object as the first parameter in the param pack (self)
                     fn_stack_frame->params[0].second = allocate_object<YosenReference>(instance);
 
+                    // Move the parameter objects into the function's stack frame
                     for (size_t i = 0; i < param_count - 1; ++i)
-                        fn_stack_frame->params[i + 1].second = param_pack->items[param_count - 2 - i]->clone();
+                        fn_stack_frame->params[i + 1].second = parameter_stack[i];
 
-                    // Set the used parameter count, excluding the "self" parameter
-                    param_pack->items_used = fn_stack_frame->params.size() - 1;
+                    parameter_stack.clear();
                 }
 
-                // Create an empty parameter stack to be used by the function for future functions
-                m_parameter_stacks.push({});
+                // Run the constructor, the instance gets stored
+                // into the register once its frame returns.
+                push_call_frame(CallFrameType::Constructor, fn_stack_frame, std::move(fn_bytecode));
+                break;
+            }
 
-                // Run the user function (return register will automatically be updated
-                execute_bytecode(fn_stack_frame, fn_bytecode);
+            // Deallocate the parameters that were not moved into a stack frame
+            free_parameter_stack(parameter_stack);
 
-                // Get the instance object from the reference again
-                instance = static_cast<YosenReference*>(fn_stack_frame->params[0].second)->obj;
+            store_allocated_object(instance);
+            break;
+        }
+        case opcodes::RET:
+        {
+            // Move the instruction pointer to the end
+            current_instruction = instruction_count;
+            return 0;
+        }
+        case opcodes::TAIL_CALL:
+        {
+            auto fn_index = ops[1];
+            auto& fn_name = stack_frame->function_names[fn_index];
+            opcount = 2;
 
-                // Deallocate the user function's stack frame
-                deallocate_stack_frame(fn_stack_frame);
+            auto& parameter_stack = m_parameter_stacks.top();
+            auto param_count = parameter_stack.size();
 
-                // Destroy the stack frame since it's a clone
-                destroy_stack_frame(fn_stack_frame);
+            auto& frame = m_call_frames.back();
 
-                // Pop the functions's parameter stack
-                m_parameter_stacks.pop();
+            // Function frames own their call stack entry, so
+            // a matching name means the function calls itself.
+            bool is_self_call = (
+                frame.type == CallFrameType::Function &&
+                m_call_stack.back().type == CallStackEntryType::Function &&
+                *m_call_stack.back().name == fn_name
+            );
 
-                // Reverse the parameters for the runtime function case
-                std::reverse(param_pack->items.begin(), param_pack->items.end());
+            // Only runtime functions can replace the frame of another runtime function,
+            // otherwise a regular call is made and the function returns once it's done.
+            if (!is_self_call &&
+                (frame.type != CallFrameType::Function || !m_env->is_static_runtime_function(fn_name)))
+            {
+                opcodes::opcode_t call_ops[] = { opcodes::CALL, fn_index, 0x00 };
+                execute_instruction(stack_frame, call_ops, current_instruction, instruction_count);
 
-                // Pop the constructor off the call stack
-                m_call_stack.pop_back();
+                current_instruction = instruction_count;
+                return 0;
             }
 
-            size_t used_params = param_pack->items_used;
-            size_t params_to_remove = param_pack->items.size() - used_params;
+            ys_runtime_function_t fn;
+            if (!is_self_call)
+                fn = m_env->get_static_runtime_function(fn_name);
 
-            // Deallocate the parameter pack object
-            for (size_t i = 0; i < params_to_remove; ++i)
-                param_pack->items.pop_back();
+            auto& expected_params = is_self_call ? frame.stack_frame->params : fn.first->params;
+            if (expected_params.size() && expected_params.size() != param_count)
+            {
+                auto ex_reason = "function \"" + fn_name + "\" expected " +
+                    std::to_string(expected_params.size()) +
+                    " arguments, received " + std::to_string(param_count) +
+                    " arguments";
 
-            free_object(param_pack);
+                // Deallocate the parameters
+                free_parameter_stack(parameter_stack);
 
-            // Remove the used objects from the parameter stack
-            for (size_t i = 0; i < used_params; ++i)
-                parameter_stack.pop_back();
+                m_env->throw_exception(RuntimeException(ex_reason));
+                return 0;
+            }
 
-            // Retrieve the original object
-            auto original_object = m_registers[RegisterType::AllocatedObjectRegister];
+            // Take the arguments before the current frame gets deallocated
+            std::vector<YosenObject*> args;
+            if (expected_params.size())
+                args.swap(parameter_stack);
 
-            // Copy the object into the register
-            m_registers[RegisterType::AllocatedObjectRegister] = instance;
+            // Deallocate the current function's variables and parameters
+            deallocate_stack_frame(frame.stack_frame);
+            parameter_stack.clear();
 
-            // Free the original object
-            if (original_object)
-                free_object(original_object);
+            // Calling itself reuses the constants and variable slots of the frame
+            if (!is_self_call)
+            {
+                // Destroy the current stack frame since it's a clone
+                destroy_stack_frame(frame.stack_frame);
 
-            break;
-        }
-        case opcodes::RET:
-        {
-            // Move the instruction pointer to the end
-            current_instruction = instruction_count;
+                frame.stack_frame = fn.first->clone();
+                frame.bytecode = std::move(fn.second);
+                frame.ops = frame.bytecode.data();
+                frame.op_count = frame.bytecode.size();
+
+                m_call_stack.back() = { CallStackEntryType::Function, &frame.stack_frame->name };
+            }
+
+#ifdef YOSEN_ENABLE_STATS
+            if (m_stats)
+                m_stats->record_function_call(m_call_stack.back());
+#endif
+
+            // Move the parameter objects into the function's stack frame
+            for (size_t i = 0; i < args.size(); ++i)
+                frame.stack_frame->params[i].second = args[i];
+
+            // Start executing the function from the beginning
+            current_instruction = 0;
             return 0;
         }
         case opcodes::SET_RUNTIME_FLAG:
@@ -784,14 +1221,13 @@ namespace yosen
         {
             auto fn_index = ops[1];
             auto has_caller = ops[2];
-            auto fn_name = stack_frame->function_names[fn_index];
+            auto& fn_name = stack_frame->function_names[fn_index];
             opcount = 3;
 
             // Process parameters
             auto& parameter_stack = m_parameter_stacks.top();
             auto param_count = parameter_stack.size();
 
-            YosenTuple* param_pack = allocate_object<YosenTuple>(parameter_stack);
             YosenObject* return_val = nullptr;
 
             if (has_caller)
@@ -799,23 +1235,25 @@ namespace yosen
                 // Member function
                 auto caller_object = *LLOref;
 
-                // Push the function name to the call stack
-                auto caller_type = caller_object->runtime_name();
-                
-                // Get the actual name of the object under the reference
+                // Get the actual object under the reference
                 YosenObject* dummy_caller = caller_object;
-                while (strcmp(caller_type, "Ref") == 0)
-                {
-                    caller_type = static_cast<YosenReference*>(dummy_caller)->obj->runtime_name();
-                    dummy_caller = static_cast<YosenReference*>(dummy_caller)->obj;
-                }
+                while (dummy_caller->is<YosenReference>())
+                    dummy_caller = dummy_caller->as<YosenReference>()->obj;
 
-                m_call_stack.push_back(caller_type + std::string("::") + fn_name);
+                // Push the function name to the call stack
+                m_call_stack.push_back({ CallStackEntryType::NativeMemberFunction, &fn_name, dummy_caller->runtime_name() });
+
+#ifdef YOSEN_ENABLE_STATS
+                if (m_stats)
+                    m_stats->record_function_call(m_call_stack.back());
+#endif
 
                 // Check if it's a native member function
                 if (caller_object->has_member_native_function(fn_name))
                 {
-                    return_val = caller_object->call_member_native_function(fn_name, param_pack);
+                    return_val = caller_object->call_member_native_function(
+                        fn_name, YosenArgs(parameter_stack.data(), param_count)
+                    );
 
                     // If the return register is not empty, deallocate the existing object
                     if (m_registers[RegisterType::ReturnRegister] != nullptr)
@@ -834,8 +1272,8 @@ namespace yosen
                 }
                 else if (caller_object->has_member_runtime_function(fn_name))
                 {
-                    // Reverse the parameters for the runtime function case
-                    std::reverse(param_pack->items.begin(), param_pack->items.end());
+                    if (!check_recursion_limit(parameter_stack))
+                        return 0;
 
                     auto fn = caller_object->get_member_runtime_function(fn_name);
 
@@ -859,11 +1297,8 @@ namespace yosen
                             // Destroy the stack frame since it's a clone
                             destroy_stack_frame(fn_stack_frame);
 
-                            // Deallocate the parameter pack object
-                            free_object(param_pack);
-
-                            // Clear the parameter stack
-                            parameter_stack.clear();
+                            // Deallocate the parameters
+                            free_parameter_stack(parameter_stack);
 
                             m_env->throw_exception(RuntimeException(ex_reason));
                             return 0;
@@ -872,38 +1307,25 @@ namespace yosen
                         // Assign the caller object as the first parameter in the param pack (self)
                         fn_stack_frame->params[0].second = allocate_object<YosenReference>(caller_object);
 
+                        // Move the parameter objects into the function's stack frame
                         for (size_t i = 0; i < param_count - 1; ++i)
-                            fn_stack_frame->params[i + 1].second = param_pack->items[param_count - 2 - i]->clone();
+                            fn_stack_frame->params[i + 1].second = parameter_stack[i];
 
-                        // Set the used parameter count, excluding the "self" parameter
-                        param_pack->items_used = fn_stack_frame->params.size() - 1;
+                        parameter_stack.clear();
                     }
 
-                    // Create an empty parameter stack to be used by the function for future functions
-                    m_parameter_stacks.push({});
-
-                    // Run the user function (return register will automatically be updated
-                    execute_bytecode(fn_stack_frame, fn_bytecode);
-
-                    // Deallocate the user function's stack frame
-                    deallocate_stack_frame(fn_stack_frame);
-
-                    // Destroy the stack frame since it's a clone
-                    destroy_stack_frame(fn_stack_frame);
+                    // Member functions are named after their class, which
+                    // keeps the entry valid even if the object gets freed.
+                    m_call_stack.back() = { CallStackEntryType::Function, &fn_stack_frame->name };
 
-                    // Pop the functions's parameter stack
-                    m_parameter_stacks.pop();
-
-                    // Reverse the parameter pack again to get it back to normal
-                    std::reverse(param_pack->items.begin(), param_pack->items.end());
+                    // Run the user function, the call finishes once its frame returns
+                    push_call_frame(CallFrameType::Function, fn_stack_frame, std::move(fn_bytecode));
+                    return opcount;
                 }
                 else
                 {
-                    // Deallocate the parameter pack object
-                    free_object(param_pack);
-
-                    // Clear the parameter stack
-                    parameter_stack.clear();
+                    // Deallocate the parameters
+                    free_parameter_stack(parameter_stack);
 
                     auto ex_reason = "Member function \"" + fn_name + "\" not found";
                     m_env->throw_exception(RuntimeException(ex_reason));
@@ -913,13 +1335,18 @@ namespace yosen
             else
             {
                 // Push the function name to the call stack
-                m_call_stack.push_back(fn_name);
+                m_call_stack.push_back({ CallStackEntryType::Function, &fn_name });
+
+#ifdef YOSEN_ENABLE_STATS
+                if (m_stats)
+                    m_stats->record_function_call(m_call_stack.back());
+#endif
 
                 // Check for a user-defined function
                 if (m_env->is_static_runtime_function(fn_name))
                 {
-                    // Reverse the parameters for the runtime function case
-                    std::reverse(param_pack->items.begin(), param_pack->items.end());
+                    if (!check_recursion_limit(parameter_stack))
+                        return 0;
 
                     auto fn = m_env->get_static_runtime_function(fn_name);
 
@@ -940,47 +1367,30 @@ namespace yosen
                             // Destroy the stack frame since it's a clone
                             destroy_stack_frame(fn_stack_frame);
 
-                            // Deallocate the parameter pack object
-                            free_object(param_pack);
-
-                            // Clear the parameter stack
-                            parameter_stack.clear();
+                            // Deallocate the parameters
+                            free_parameter_stack(parameter_stack);
 
                             m_env->throw_exception(RuntimeException(ex_reason));
                             return 0;
                         }
 
+                        // Move the parameter objects into the function's stack frame
                         for (size_t i = 0; i < param_count; ++i)
-                            fn_stack_frame->params[i].second = param_pack->items[param_count - 1 - i]->clone();
+                            fn_stack_frame->params[i].second = parameter_stack[i];
 
-                        // Set the used parameter count
-                        param_pack->items_used = fn_stack_frame->params.size();
+                        parameter_stack.clear();
                     }
 
-                    // Create an empty parameter stack to be used by the function for future functions
-                    m_parameter_stacks.push({});
-
-                    // Run the user function (return register will automatically be updated
-                    execute_bytecode(fn_stack_frame, fn_bytecode);
-
-                    // Deallocate the user function's stack frame
-                    deallocate_stack_frame(fn_stack_frame);
-
-                    // Destroy the stack frame since it's a clone
-                    destroy_stack_frame(fn_stack_frame);
-
-                    // Pop the functions's parameter stack
-                    m_parameter_stacks.pop();
-
-                    // Reverse the parameter pack again to get it back to normal
-                    std::reverse(param_pack->items.begin(), param_pack->items.end());
+                    // Run the user function, the call finishes once its frame returns
+                    push_call_frame(CallFrameType::Function, fn_stack_frame, std::move(fn_bytecode));
+                    return opcount;
                 }
 
                 // Check for a native function
                 else if (m_env->is_static_native_function(fn_name))
                 {
                     auto fn = m_env->get_static_native_function(fn_name);
-                    return_val = fn(param_pack);
+                    return_val = fn(YosenArgs(parameter_stack.data(), param_count));
 
                     // If the return register is not empty, deallocate the existing object
                     if (m_registers[RegisterType::ReturnRegister] != nullptr)
@@ -999,11 +1409,8 @@ namespace yosen
                 }
                 else
                 {
-                    // Deallocate the parameter pack object
-                    free_object(param_pack);
-
-                    // Clear the parameter stack
-                    parameter_stack.clear();
+                    // Deallocate the parameters
+                    free_parameter_stack(parameter_stack);
 
                     auto ex_reason = "Static function \"" + fn_name + "\" not found";
                     m_env->throw_exception(RuntimeException(ex_reason));
@@ -1011,18 +1418,12 @@ namespace yosen
                 }
             }
 
-            size_t used_params = param_pack->items_used;
-            size_t params_to_remove = param_pack->items.size() - used_params;
-
-            // Deallocate the parameter pack object
-            for (size_t i = 0; i < params_to_remove; ++i)
-                param_pack->items.pop_back();
-
-            free_object(param_pack);
+            // Deallocate the parameters that were not moved into a stack frame
+            free_parameter_stack(parameter_stack);
 
-            // Remove the used objects from the parameter stack
-            for (size_t i = 0; i < used_params; ++i)
-                parameter_stack.pop_back();
+            // Time spent in the native function is attributed to it
+            if (m_profiler && m_profiler->has_pending_samples())
+                record_profiler_sample();
 
             // Pop the function name off the call stack
             m_call_stack.pop_back();
@@ -1,6 +1,10 @@
 #pragma once
 #include "YosenCompiler.h"
+#include "YosenProfiler.h"
+#include "YosenInterpreterStats.h"
 #include <stack>
+#include <optional>
+#include <functional>
 
 namespace yosen
 {
@@ -17,11 +21,40 @@ namespace yosen
 		SequenceFunctionCall	= 0x00000001,
 	};
 
-	class YosenInterpreter
+	enum class CallFrameType
+	{
+		Entry,		 // bytecode executed on behalf of native code
+		Function,	 // runtime function call
+		Constructor, // runtime class constructor call
+	};
+
+	// Execution state of a single function call
+	struct CallFrame
+	{
+		CallFrameType	type = CallFrameType::Entry;
+		StackFramePtr	stack_frame;
+
+		// Copy of the function's bytecode, empty for entry frames
+		bytecode_t		bytecode;
+
+		opcodes::opcode_t*	ops = nullptr;
+		size_t				op_count = 0;
+
+		// Index of the next opcode to execute
+		size_t				ip = 0;
+	};
+
+	class YosenInterpreter : public YosenExecutionContext
 	{
 	public:
-		// Initializes the runtime environment
-		void init();
+		// Initializes the interpreter with the given environment.
+		// ** Initializes and uses the default environment if none is given,
+		//    each interpreter running in parallel needs its own environment.
+		void init(YosenEnvironment* env = nullptr);
+
+		// Initializes the interpreter as an execution context that only
+		// calls the runtime functions already compiled into the environment.
+		void init_execution_context(YosenEnvironment* env);
 
 		// Shuts down the runtime environment and deallocates memory
 		void shutdown();
@@ -30,6 +63,10 @@ namespace yosen
 		// ** Expects an entry point defined as "main" by default.
 		void run_source(std::string& source, const std::vector<std::string>& cmd_arguments);
 
+		// Compiles a complete string of source code and prints the bytecode
+		// of every compiled function instead of running the program.
+		void disassemble_source(std::string& source, const std::vector<std::string>& cmd_arguments);
+
 		// Creates an interactive Yosen console that accepts
 		// a continuous input of source code commands.
 		void run_interactive_shell();
@@ -44,10 +81,37 @@ namespace yosen
 		// stack frame making each stack frame unusable.
 		void destroy_stack_frame(StackFramePtr stack_frame);
 
+		// Frees all the objects left on the given parameter stack
+		void free_parameter_stack(std::vector<YosenObject*>& parameter_stack);
+
+		// Calls a runtime or native function by its name with copies of the arguments
+		YosenObject* call_function(const std::string& name, YosenArgs args) override;
+
+		// Returns the exception that stopped the last call_function() call
+		const YosenException* get_last_exception() const override;
+
+		// Sets the maximum number of nested function calls
+		inline void set_recursion_limit(size_t limit) { m_recursion_limit = limit; }
+
+		// Attaches a profiler that samples the call stack, or detaches it if null
+		inline void set_profiler(YosenProfiler* profiler) { m_profiler = profiler; }
+
+		// Sets a function called right before an uncaught exception exits the process,
+		// so that the caller can still report the results of the failed run.
+		inline void set_exit_handler(const std::function<void()>& handler) { m_exit_handler = handler; }
+
+		// Starts counting the executed opcodes, function calls and allocations, the summary
+		// is printed on shutdown. Returns false if built without YOSEN_ENABLE_STATS.
+		bool enable_stats();
+
 	private:
-		YosenEnvironment*	m_env;
+		YosenEnvironment*	m_env = nullptr;
 		YosenCompiler		m_compiler;
 
+		// Specifies whether the interpreter only serves as
+		// an execution context for calls from native code.
+		bool m_execution_context_mode = false;
+
 		// Specifies whether the interpreter is
 		// running in the interactive console mode.
 		bool m_interactive_mode = false;
@@ -56,6 +120,19 @@ namespace yosen
 		// the current command due to an exception occuring.
 		bool m_interactive_shell_exception_occured = false;
 
+		// First exception thrown during the current execution context call,
+		// the call stops interpreting once it is set.
+		std::optional<YosenException> m_execution_context_exception;
+
+		// Copies of the global variables loaded by a task running on the task pool,
+		// since other threads may replace and free the environment's objects.
+		std::map<uint32_t, YosenObject*> m_global_copies;
+		uint64_t m_global_copies_version = 0;
+
+		// Copies that went out of date while they could still be
+		// on the operation stack, freed along with the registers.
+		std::vector<YosenObject*> m_stale_global_copies;
+
 		// Command line arguments for a full
 		// program's entry point function.
 		YosenObject* m_entry_point_args = nullptr;
@@ -87,6 +164,27 @@ namespace yosen
 		// All allocated stack frames
 		std::vector<StackFramePtr> m_allocated_stack_frames;
 
+		// Frames of the functions currently being executed, runtime
+		// function calls don't grow the native stack of the interpreter.
+		std::vector<CallFrame> m_call_frames;
+
+		// Maximum number of nested function calls
+		size_t m_recursion_limit = 10000;
+
+		// Name of the function called to run a complete program
+		std::string m_entry_point_name = "main";
+
+		// Optional profiler sampling the call stack
+		YosenProfiler* m_profiler = nullptr;
+
+		// Called before exiting the process due to an uncaught exception
+		std::function<void()> m_exit_handler;
+
+#ifdef YOSEN_ENABLE_STATS
+		// Execution counters, only allocated in the --stats mode
+		std::unique_ptr<YosenInterpreterStats> m_stats;
+#endif
+
 	private:
 		// Executes a single instruction that could consist of single or multiple opcodes.
 		// Returns number of opcodes processed.
@@ -98,12 +196,34 @@ namespace yosen
 		// Helper function to interpreter runtime binary and boolean operations
 		void execute_runtime_operator_instruction(RuntimeOperator op);
 
+		// Frees the objects held by the registers and the operation stack
+		void free_register_objects();
+
+		// Returns the calling task's up to date copy of a global variable
+		YosenObject*& load_global_copy(uint32_t key);
+
+		// Throws an exception and frees the parameters
+		// if another call would exceed the recursion limit.
+		bool check_recursion_limit(std::vector<YosenObject*>& parameter_stack);
+
+		// Starts executing the function in the given stack frame
+		void push_call_frame(CallFrameType type, StackFramePtr stack_frame, bytecode_t&& bytecode);
+
+		// Finishes the call of the function in the top frame
+		void pop_call_frame();
+
+		// Replaces the allocated object register with a new object
+		void store_allocated_object(YosenObject* instance);
+
+		// Attributes the elapsed profiler ticks to the current call stack
+		void record_profiler_sample();
+
 	private:
 		// Main exception handler
 		void main_exception_handler(const YosenException& ex);
 
 		// Stack of functions that have entered their execution
-		std::vector<std::string> m_call_stack;
+		std::vector<CallStackEntry> m_call_stack;
 
 		// Helper function that prints out a
 		// proper traceback through the call stack.
@@ -0,0 +1,172 @@
+#include "YosenInterpreterStats.h"
+#include <algorithm>
+#include <vector>
+#include <cstdio>
+
+namespace yosen
+{
+#ifdef YOSEN_STATS_CYCLE_COUNTER
+    static constexpr auto s_tick_unit = "cycles";
+#else
+    static constexpr auto s_tick_unit = "ns";
+#endif
+
+    // Groups of opcodes with similar costs
+    static const char* get_opcode_class(opcodes::opcode_t op)
+    {
+        switch (op)
+        {
+        case opcodes::LOAD:
+        case opcodes::LOAD_CONST:
+        case opcodes::LOAD_PARAM:
+        case opcodes::LOAD_MEMBER:
+        case opcodes::LOAD_GLOBAL:
+            return "load";
+        case opcodes::STORE:
+        case opcodes::STORE_MEMBER:
+        case opcodes::STORE_GLOBAL:
+            return "store";
+        case opcodes::CALL:
+        case opcodes::RET:
+        case opcodes::TAIL_CALL:
+            return "call";
+        case opcodes::PUSH:
+        case opcodes::POP:
+        case opcodes::PUSH_OP:
+        case opcodes::POP_OP:
+        case opcodes::PUSH_OP_NO_CLONE:
+        case opcodes::POP_OP_NO_FREE:
+            return "stack";
+        case opcodes::REG_LOAD:
+        case opcodes::REG_STORE:
+            return "register";
+        case opcodes::ADD:
+        case opcodes::SUB:
+        case opcodes::MUL:
+        case opcodes::DIV:
+        case opcodes::MOD:
+        case opcodes::EQU:
+        case opcodes::NOTEQU:
+        case opcodes::GREATER:
+        case opcodes::LESS:
+        case opcodes::OR:
+        case opcodes::AND:
+            return "operator";
+        case opcodes::JMP:
+        case opcodes::JMP_IF_FALSE:
+            return "jump";
+        case opcodes::ALLOC_OBJECT:
+            return "object";
+        default:
+            return "other";
+        }
+    }
+
+    void YosenInterpreterStats::record_function_call(const CallStackEntry& entry)
+    {
+        m_name_buffer.clear();
+        entry.append_name(m_name_buffer);
+
+        auto it = m_function_calls.find(m_name_buffer);
+        if (it == m_function_calls.end())
+            it = m_function_calls.emplace(m_name_buffer, 0).first;
+
+        ++it->second;
+    }
+
+    void YosenInterpreterStats::print_summary(size_t max_functions) const
+    {
+        struct ClassStats
+        {
+            uint64_t count = 0;
+            uint64_t ticks = 0;
+            uint64_t allocations = 0;
+        };
+
+        std::vector<size_t> opcodes_by_count;
+        std::vector<std::pair<const char*, ClassStats>> classes;
+        uint64_t total_count = 0;
+        uint64_t total_ticks = 0;
+
+        for (size_t op = 0; op < OpcodeSlotCount; ++op)
+        {
+            if (!m_opcode_counts[op])
+                continue;
+
+            opcodes_by_count.push_back(op);
+            total_count += m_opcode_counts[op];
+            total_ticks += m_opcode_ticks[op];
+
+            auto class_name = get_opcode_class(static_cast<opcodes::opcode_t>(op));
+            auto it = std::find_if(classes.begin(), classes.end(), [class_name](auto& entry) {
+                return entry.first == class_name;
+            });
+
+            if (it == classes.end())
+                it = classes.insert(classes.end(), { class_name, {} });
+
+            it->second.count += m_opcode_counts[op];
+            it->second.ticks += m_opcode_ticks[op];
+            it->second.allocations += m_opcode_allocations[op];
+        }
+
+        std::sort(opcodes_by_count.begin(), opcodes_by_count.end(), [this](size_t a, size_t b) {
+            return m_opcode_counts[a] > m_opcode_counts[b];
+        });
+
+        std::sort(classes.begin(), classes.end(), [](auto& a, auto& b) {
+            return a.second.ticks > b.second.ticks;
+        });
+
+        auto percentage = [](uint64_t value, uint64_t total) {
+            return total ? value * 100.0 / total : 0.0;
+        };
+
+        fprintf(stderr, "\nOpcodes: %llu executed\n", static_cast<unsigned long long>(total_count));
+        fprintf(stderr, "%-18s %14s %7s %11s/op %12s\n", "opcode", "count", "count%", s_tick_unit, "allocations");
+
+        for (auto op : opcodes_by_count)
+        {
+            auto name = opcodes::get_opcode_name(static_cast<opcodes::opcode_t>(op));
+
+            fprintf(stderr, "%-18s %14llu %6.1f%% %14.1f %12llu\n",
+                name ? name : "?",
+                static_cast<unsigned long long>(m_opcode_counts[op]),
+                percentage(m_opcode_counts[op], total_count),
+                static_cast<double>(m_opcode_ticks[op]) / m_opcode_counts[op],
+                static_cast<unsigned long long>(m_opcode_allocations[op])
+            );
+        }
+
+        fprintf(stderr, "\nOpcode classes:\n");
+        fprintf(stderr, "%-18s %14s %14s %7s %12s\n", "class", "count", s_tick_unit, "time%", "allocations");
+
+        for (auto& [class_name, class_stats] : classes)
+        {
+            fprintf(stderr, "%-18s %14llu %14llu %6.1f%% %12llu\n",
+                class_name,
+                static_cast<unsigned long long>(class_stats.count),
+                static_cast<unsigned long long>(class_stats.ticks),
+                percentage(class_stats.ticks, total_ticks),
+                static_cast<unsigned long long>(class_stats.allocations)
+            );
+        }
+
+        std::vector<std::pair<std::string, uint64_t>> functions(m_function_calls.begin(), m_function_calls.end());
+        std::sort(functions.begin(), functions.end(), [](auto& a, auto& b) {
+            if (a.second != b.second)
+                return a.second > b.second;
+
+            return a.first < b.first;
+        });
+
+        if (functions.size() > max_functions)
+            functions.resize(max_functions);
+
+        fprintf(stderr, "\nFunction calls:\n");
+        fprintf(stderr, "%14s  %s\n", "calls", "function");
+
+        for (auto& [name, calls] : functions)
+            fprintf(stderr, "%14llu  %s\n", static_cast<unsigned long long>(calls), name.c_str());
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include "opcodes.h"
+#include "CallStack.h"
+#include <primitives/AllocationStats.h>
+#include <array>
+#include <unordered_map>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+	#ifdef _MSC_VER
+		#include <intrin.h>
+	#else
+		#include <x86intrin.h>
+	#endif
+	#define YOSEN_STATS_CYCLE_COUNTER 1
+#else
+	#include <chrono>
+#endif
+
+namespace yosen
+{
+	// Execution counters of the --stats mode. The interpreter only
+	// records them when it's built with the YOSEN_ENABLE_STATS option.
+	class YosenInterpreterStats
+	{
+	public:
+		// Counters read before an instruction is executed
+		struct InstructionStart
+		{
+			uint64_t ticks = 0;
+			uint64_t allocations = 0;
+		};
+
+		inline InstructionStart begin_instruction() const
+		{
+			return { read_ticks(), get_thread_allocation_count() };
+		}
+
+		// Attributes the time and allocations since the start to the opcode
+		inline void end_instruction(opcodes::opcode_t opcode, const InstructionStart& start)
+		{
+			auto idx = static_cast<size_t>(opcode) % OpcodeSlotCount;
+
+			++m_opcode_counts[idx];
+			m_opcode_ticks[idx] += read_ticks() - start.ticks;
+			m_opcode_allocations[idx] += get_thread_allocation_count() - start.allocations;
+		}
+
+		// Counts a call of the function described by the entry
+		void record_function_call(const CallStackEntry& entry);
+
+		// Prints the opcode, opcode class and function call tables
+		void print_summary(size_t max_functions = 20) const;
+
+	private:
+		static constexpr size_t OpcodeSlotCount = 256;
+
+		std::array<uint64_t, OpcodeSlotCount> m_opcode_counts = {};
+		std::array<uint64_t, OpcodeSlotCount> m_opcode_ticks = {};
+		std::array<uint64_t, OpcodeSlotCount> m_opcode_allocations = {};
+
+		std::unordered_map<std::string, uint64_t> m_function_calls;
+		std::string m_name_buffer;
+
+	private:
+		// Returns the CPU cycle counter, or nanoseconds where it's unavailable
+		static inline uint64_t read_ticks()
+		{
+#ifdef YOSEN_STATS_CYCLE_COUNTER
+			return __rdtsc();
+#else
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()
+			).count();
+#endif
+		}
+	};
+}
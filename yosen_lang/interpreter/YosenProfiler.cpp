@@ -0,0 +1,249 @@
+#include "YosenProfiler.h"
+#include <algorithm>
+#include <cstdio>
+
+#ifdef _WIN32
+    #include <thread>
+    #include <chrono>
+#else
+    #include <signal.h>
+    #include <sys/time.h>
+    #include <time.h>
+#endif
+
+namespace yosen
+{
+    std::atomic<uint32_t> YosenProfiler::s_pending_ticks = 0;
+
+#ifdef _WIN32
+    // Without profiling signals, a thread sleeping for each interval counts the ticks
+    static std::atomic<bool> s_timer_thread_running = false;
+    static std::thread s_timer_thread;
+#else
+    static struct sigaction s_previous_sigprof_action;
+#endif
+
+    static bool s_profiler_active = false;
+
+    YosenProfiler::YosenProfiler(uint32_t interval_us)
+        : m_interval_us(std::max<uint32_t>(interval_us, 1)) {}
+
+    YosenProfiler::~YosenProfiler()
+    {
+        stop();
+    }
+
+    void YosenProfiler::tick()
+    {
+        s_pending_ticks.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t YosenProfiler::get_clock_us()
+    {
+#ifdef _WIN32
+        auto now = std::chrono::steady_clock::now().time_since_epoch();
+        return std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+#else
+        timespec now;
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+
+        return static_cast<uint64_t>(now.tv_sec) * 1000000 + now.tv_nsec / 1000;
+#endif
+    }
+
+    bool YosenProfiler::start()
+    {
+        if (s_profiler_active)
+            return false;
+
+        s_pending_ticks = 0;
+        m_last_sample_time_us = get_clock_us();
+
+#ifdef _WIN32
+        s_timer_thread_running = true;
+        s_timer_thread = std::thread([interval_us = m_interval_us]() {
+            while (s_timer_thread_running)
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(interval_us));
+                tick();
+            }
+        });
+#else
+        struct sigaction action = {};
+        action.sa_handler = [](int) { tick(); };
+        action.sa_flags = SA_RESTART;
+        sigemptyset(&action.sa_mask);
+
+        if (sigaction(SIGPROF, &action, &s_previous_sigprof_action) != 0)
+            return false;
+
+        // The timer only advances while the process is using the CPU
+        itimerval timer = {};
+        timer.it_interval.tv_sec = m_interval_us / 1000000;
+        timer.it_interval.tv_usec = m_interval_us % 1000000;
+        timer.it_value = timer.it_interval;
+
+        if (setitimer(ITIMER_PROF, &timer, nullptr) != 0)
+        {
+            sigaction(SIGPROF, &s_previous_sigprof_action, nullptr);
+            return false;
+        }
+#endif
+
+        s_profiler_active = true;
+        m_running = true;
+        return true;
+    }
+
+    void YosenProfiler::stop()
+    {
+        if (!m_running)
+            return;
+
+#ifdef _WIN32
+        s_timer_thread_running = false;
+        s_timer_thread.join();
+#else
+        itimerval timer = {};
+        setitimer(ITIMER_PROF, &timer, nullptr);
+
+        sigaction(SIGPROF, &s_previous_sigprof_action, nullptr);
+#endif
+
+        s_profiler_active = false;
+        m_running = false;
+    }
+
+    void YosenProfiler::record_sample(const std::string& entry_point_name, const std::vector<CallStackEntry>& call_stack)
+    {
+        auto ticks = s_pending_ticks.exchange(0, std::memory_order_relaxed);
+        if (!ticks)
+            return;
+
+        // The timer's resolution may be coarser than the requested interval
+        auto now_us = get_clock_us();
+        auto elapsed_us = now_us - m_last_sample_time_us;
+        m_last_sample_time_us = now_us;
+
+        // Walk down the call tree, adding the missing functions
+        auto node = &m_call_tree;
+        auto enter_function = [&node](const std::string& name) {
+            auto it = node->children.find(name);
+            if (it == node->children.end())
+                it = node->children.emplace(name, std::make_unique<CallTreeNode>()).first;
+
+            node = it->second.get();
+        };
+
+        enter_function(entry_point_name);
+
+        // Names are formatted into a reused buffer
+        for (auto& entry : call_stack)
+        {
+            m_name_buffer.clear();
+            entry.append_name(m_name_buffer);
+
+            enter_function(m_name_buffer);
+        }
+
+        node->self_time_us += elapsed_us;
+        m_total_time_us += elapsed_us;
+        ++m_sample_count;
+    }
+
+    bool YosenProfiler::write_folded_stacks(const std::string& path)
+    {
+        auto file = fopen(path.c_str(), "w");
+        if (!file)
+            return false;
+
+        std::string stack_path;
+        for (auto& [name, child] : m_call_tree.children)
+        {
+            stack_path = name;
+            write_folded_node(stack_path, *child, file);
+        }
+
+        fclose(file);
+        return true;
+    }
+
+    void YosenProfiler::write_folded_node(std::string& path, const CallTreeNode& node, FILE* file)
+    {
+        if (node.self_time_us)
+            fprintf(file, "%s %llu\n", path.c_str(), static_cast<unsigned long long>(node.self_time_us));
+
+        for (auto& [name, child] : node.children)
+        {
+            auto path_length = path.size();
+
+            path += ";";
+            path += name;
+            write_folded_node(path, *child, file);
+
+            path.resize(path_length);
+        }
+    }
+
+    uint64_t YosenProfiler::collect_function_stats(
+        const std::string& name,
+        const CallTreeNode& node,
+        std::map<std::string, size_t>& active_functions,
+        std::map<std::string, FunctionStats>& stats
+    )
+    {
+        auto& function_stats = stats[name];
+        function_stats.self_time_us += node.self_time_us;
+
+        // Recursive calls are already included in the total of the outermost call
+        bool is_outermost_call = (active_functions[name]++ == 0);
+
+        uint64_t node_time_us = node.self_time_us;
+        for (auto& [child_name, child] : node.children)
+            node_time_us += collect_function_stats(child_name, *child, active_functions, stats);
+
+        if (is_outermost_call)
+            function_stats.total_time_us += node_time_us;
+
+        --active_functions[name];
+        return node_time_us;
+    }
+
+    void YosenProfiler::print_summary(size_t max_functions)
+    {
+        std::map<std::string, size_t> active_functions;
+        std::map<std::string, FunctionStats> stats;
+
+        for (auto& [name, child] : m_call_tree.children)
+            collect_function_stats(name, *child, active_functions, stats);
+
+        std::vector<std::pair<std::string, FunctionStats>> functions(stats.begin(), stats.end());
+        std::sort(functions.begin(), functions.end(), [](auto& a, auto& b) {
+            if (a.second.self_time_us != b.second.self_time_us)
+                return a.second.self_time_us > b.second.self_time_us;
+
+            return a.second.total_time_us > b.second.total_time_us;
+        });
+
+        if (functions.size() > max_functions)
+            functions.resize(max_functions);
+
+        double total_time_us = static_cast<double>(std::max<uint64_t>(m_total_time_us, 1));
+
+        fprintf(stderr, "\nProfile: %llu samples, %.2f ms\n",
+            static_cast<unsigned long long>(m_sample_count), m_total_time_us / 1000.0);
+
+        fprintf(stderr, "%12s %7s %12s %7s  %s\n", "self (ms)", "self%", "total (ms)", "total%", "function");
+
+        for (auto& [name, function_stats] : functions)
+        {
+            fprintf(stderr, "%12.2f %6.1f%% %12.2f %6.1f%%  %s\n",
+                function_stats.self_time_us / 1000.0,
+                function_stats.self_time_us * 100.0 / total_time_us,
+                function_stats.total_time_us / 1000.0,
+                function_stats.total_time_us * 100.0 / total_time_us,
+                name.c_str()
+            );
+        }
+    }
+}
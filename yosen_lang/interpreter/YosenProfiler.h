@@ -0,0 +1,82 @@
+#pragma once
+#include "CallStack.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <atomic>
+
+namespace yosen
+{
+	// Sampling profiler for the runtime functions. A timer only counts the
+	// elapsed ticks, the interpreter attributes them to its call stack
+	// in between instructions, so function calls themselves cost nothing.
+	// Each sample is weighted by the CPU time elapsed since the previous one.
+	class YosenProfiler
+	{
+	public:
+		YosenProfiler(uint32_t interval_us = 1000);
+		~YosenProfiler();
+
+		// Starts the sampling timer, only one profiler can run at a time
+		bool start();
+
+		// Stops the sampling timer
+		void stop();
+
+		// Returns whether any ticks have elapsed since the last sample
+		inline bool has_pending_samples() const { return s_pending_ticks.load(std::memory_order_relaxed) != 0; }
+
+		// Attributes the time elapsed since the last sample to the given call stack
+		void record_sample(const std::string& entry_point_name, const std::vector<CallStackEntry>& call_stack);
+
+		// Writes a line per unique call stack in the folded format
+		// "main;fn_a;fn_b <microseconds>" used by the flamegraph tools.
+		bool write_folded_stacks(const std::string& path);
+
+		// Prints the functions with the highest self time
+		void print_summary(size_t max_functions = 20);
+
+	private:
+		struct CallTreeNode
+		{
+			std::map<std::string, std::unique_ptr<CallTreeNode>> children;
+
+			// Time sampled while this function was on the top of the stack
+			uint64_t self_time_us = 0;
+		};
+
+		struct FunctionStats
+		{
+			uint64_t self_time_us = 0;
+			uint64_t total_time_us = 0;
+		};
+
+		CallTreeNode	m_call_tree;
+		std::string		m_name_buffer;
+		uint64_t		m_sample_count = 0;
+		uint64_t		m_total_time_us = 0;
+		uint64_t		m_last_sample_time_us = 0;
+		uint32_t		m_interval_us;
+		bool			m_running = false;
+
+		// Ticks counted by the timer and not yet attributed to a call stack
+		static std::atomic<uint32_t> s_pending_ticks;
+
+	private:
+		// Returns the time sampled in the node and all its children
+		uint64_t collect_function_stats(
+			const std::string& name,
+			const CallTreeNode& node,
+			std::map<std::string, size_t>& active_functions,
+			std::map<std::string, FunctionStats>& stats
+		);
+
+		void write_folded_node(std::string& path, const CallTreeNode& node, FILE* file);
+
+		static void tick();
+
+		// Returns the CPU time used by the process, or the elapsed time where it's unavailable
+		static uint64_t get_clock_us();
+	};
+}
@@ -47,6 +47,10 @@ namespace yosen
 		// No operands
 		constexpr opcode_t RET			= 0x61;
 
+		// Calls a static function and returns its result, the callee replaces the current function's frame.
+		// Operand: index of the function's name in the frame's functions array.
+		constexpr opcode_t TAIL_CALL	= 0x62;
+
 		// Copies the last loaded object onto the stack frame's parameter stack.
 		// No operands
 		constexpr opcode_t PUSH			= 0x81;
@@ -158,5 +162,78 @@ namespace yosen
 		constexpr opcode_t SET_RUNTIME_FLAG = 0x08;
 
 #define RETURN REG_STORE, 0x02
+
+		// Returns the mnemonic of the opcode, or nullptr if it's unknown
+		inline const char* get_opcode_name(opcode_t op)
+		{
+			switch (op)
+			{
+			case LOAD:				return "LOAD";
+			case LOAD_CONST:		return "LOAD_CONST";
+			case LOAD_PARAM:		return "LOAD_PARAM";
+			case STORE:				return "STORE";
+			case LOAD_MEMBER:		return "LOAD_MEMBER";
+			case STORE_MEMBER:		return "STORE_MEMBER";
+			case LOAD_GLOBAL:		return "LOAD_GLOBAL";
+			case STORE_GLOBAL:		return "STORE_GLOBAL";
+			case CALL:				return "CALL";
+			case RET:				return "RET";
+			case TAIL_CALL:			return "TAIL_CALL";
+			case PUSH:				return "PUSH";
+			case POP:				return "POP";
+			case PUSH_OP:			return "PUSH_OP";
+			case POP_OP:			return "POP_OP";
+			case PUSH_OP_NO_CLONE:	return "PUSH_OP_NO_CLONE";
+			case POP_OP_NO_FREE:	return "POP_OP_NO_FREE";
+			case REG_LOAD:			return "REG_LOAD";
+			case REG_STORE:			return "REG_STORE";
+			case ALLOC_OBJECT:		return "ALLOC_OBJECT";
+			case IMPORT_LIB:		return "IMPORT_LIB";
+			case ADD:				return "ADD";
+			case SUB:				return "SUB";
+			case MUL:				return "MUL";
+			case DIV:				return "DIV";
+			case MOD:				return "MOD";
+			case EQU:				return "EQU";
+			case NOTEQU:			return "NOTEQU";
+			case GREATER:			return "GREATER";
+			case LESS:				return "LESS";
+			case OR:				return "OR";
+			case AND:				return "AND";
+			case JMP:				return "JMP";
+			case JMP_IF_FALSE:		return "JMP_IF_FALSE";
+			case SET_RUNTIME_FLAG:	return "SET_RUNTIME_FLAG";
+			default:				return nullptr;
+			}
+		}
+
+		// Returns the number of operands that follow the opcode in the bytecode
+		inline unsigned int get_opcode_operand_count(opcode_t op)
+		{
+			switch (op)
+			{
+			case CALL:
+				return 2;
+			case LOAD:
+			case LOAD_CONST:
+			case LOAD_PARAM:
+			case STORE:
+			case LOAD_MEMBER:
+			case STORE_MEMBER:
+			case LOAD_GLOBAL:
+			case STORE_GLOBAL:
+			case TAIL_CALL:
+			case REG_LOAD:
+			case REG_STORE:
+			case ALLOC_OBJECT:
+			case IMPORT_LIB:
+			case JMP:
+			case JMP_IF_FALSE:
+			case SET_RUNTIME_FLAG:
+				return 1;
+			default:
+				return 0;
+			}
+		}
 	}
 }
\ No newline at end of file
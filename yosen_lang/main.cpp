@@ -1,8 +1,10 @@
 #include <filesystem>
 #include <fstream>
 #include <sstream>
+#include <cstring>
 
 #include "interpreter/YosenInterpreter.h"
+#include <primitives/AllocationStats.h>
 using namespace yosen;
 
 int main(int argc, char** argv)
@@ -10,15 +12,40 @@ int main(int argc, char** argv)
     std::string source_code = "";
     std::vector<std::string> cmd_arguments;
 
-    if (argc > 1)
+    // Interpreter options preceding the source file path
+    std::string profile_output_path;
+    bool stats_enabled = false;
+    bool alloc_stats_enabled = false;
+    bool disassemble = false;
+
+    int arg_idx = 1;
+    for (; arg_idx < argc; ++arg_idx)
     {
-        for (int i = 1; i < argc; ++i)
-            cmd_arguments.push_back(argv[i]);
+        std::string option = argv[arg_idx];
+        if (option.rfind("--", 0) != 0)
+            break;
+
+        if (option.rfind("--profile=", 0) == 0)
+            profile_output_path = option.substr(strlen("--profile="));
+        else if (option == "--stats")
+            stats_enabled = true;
+        else if (option == "--alloc-stats")
+            alloc_stats_enabled = true;
+        else if (option == "--dis")
+            disassemble = true;
+        else
+        {
+            fprintf(stderr, "Unknown option \"%s\"\n", option.c_str());
+            return 1;
+        }
     }
 
-    if (argc > 1)
+    for (int i = arg_idx; i < argc; ++i)
+        cmd_arguments.push_back(argv[i]);
+
+    if (arg_idx < argc)
     {
-        std::string input_source_path = argv[1];
+        std::string input_source_path = argv[arg_idx];
         if (input_source_path.empty() || !std::filesystem::is_regular_file(input_source_path))
         {
             printf("Invalid input source file specified\n");
@@ -35,11 +62,59 @@ int main(int argc, char** argv)
 	auto interpreter = std::make_unique<YosenInterpreter>();
 	interpreter->init();
 
-    if (argc == 1)
+    if (stats_enabled && !interpreter->enable_stats())
+        printf("The interpreter was built without YOSEN_ENABLE_STATS, --stats is ignored\n");
+
+    YosenProfiler profiler;
+    if (!profile_output_path.empty())
+    {
+        if (profiler.start())
+            interpreter->set_profiler(&profiler);
+        else
+            printf("Failed to start the profiler\n");
+    }
+
+    // Reports the results of the run, an uncaught
+    // exception calls it before exiting the process.
+    auto finish_run = [&]() {
+        if (!profile_output_path.empty())
+        {
+            profiler.stop();
+            interpreter->set_profiler(nullptr);
+
+            if (!profiler.write_folded_stacks(profile_output_path))
+                printf("Failed to write the profile to \"%s\"\n", profile_output_path.c_str());
+
+            profiler.print_summary();
+        }
+
+        // Machine readable allocation totals, used by the benchmark runner
+        if (alloc_stats_enabled)
+        {
+            auto alloc_stats = get_allocation_stats();
+
+            fprintf(stderr, "allocations: %llu\n", static_cast<unsigned long long>(alloc_stats.total_allocations));
+            fprintf(stderr, "peak_live_shallow_bytes: %llu\n", static_cast<unsigned long long>(alloc_stats.peak_live_shallow_bytes));
+        }
+    };
+
+    interpreter->set_exit_handler(finish_run);
+
+    if (disassemble)
+    {
+        if (arg_idx == argc)
+            printf("No source file specified to disassemble\n");
+        else
+            interpreter->disassemble_source(source_code, cmd_arguments);
+    }
+    else if (arg_idx == argc)
         interpreter->run_interactive_shell();
     else
         interpreter->run_source(source_code, cmd_arguments);
 
+    interpreter->set_exit_handler(nullptr);
+    finish_run();
+
 	interpreter->shutdown();
 	return 0;
 }
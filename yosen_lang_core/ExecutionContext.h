@@ -0,0 +1,27 @@
+#pragma once
+#include <primitives/YosenObject.h>
+#include "YosenException.h"
+#include <memory>
+
+namespace yosen
+{
+	// Independent execution state that allows native code to call
+	// runtime functions, such as from another thread. Each context
+	// can only be used by a single thread at a time.
+	class YosenExecutionContext
+	{
+	public:
+		virtual ~YosenExecutionContext() = default;
+
+		// Calls a runtime or native function by its name, the arguments are
+		// copied into the function and the returned object is owned by the caller.
+		// An exception thrown during the call stops it without reaching the
+		// environment's exception handlers, and nullptr is returned instead.
+		virtual YosenObject* call_function(const std::string& name, YosenArgs args) = 0;
+
+		// Returns the exception that stopped the last call, or nullptr if it completed
+		virtual const YosenException* get_last_exception() const = 0;
+	};
+
+	using ys_execution_context_factory_t = std::function<std::unique_ptr<YosenExecutionContext>()>;
+}
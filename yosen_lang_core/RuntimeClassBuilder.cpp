@@ -5,7 +5,7 @@ namespace yosen
 {
 	void RuntimeClassBuilder::create_runtime_class()
 	{
-		YosenEnvironment::get().register_yosen_class(class_name, [this](YosenObject* args) -> YosenObject* {
+		YosenEnvironment::get().register_yosen_class(class_name, [this](YosenArgs args) -> YosenObject* {
 			auto instance = allocate_object<YosenObject>();
 			instance->override_runtime_name(class_name);
 
@@ -11,7 +11,7 @@ namespace yosen
         var_keys.insert({ name, var_key });
 
         // Create an entry in the variables map
-        vars.insert({ var_key, obj ? obj : YosenObject_Null->clone() });
+        vars.insert({ var_key, obj ? obj : YosenObject_Null });
     }
     
     bool StackFrame::has_variable(const std::string& name) const
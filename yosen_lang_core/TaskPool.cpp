@@ -0,0 +1,202 @@
+#include "TaskPool.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace yosen
+{
+	// Pool and queue index of the worker running on the current thread
+	static thread_local YosenTaskPool* s_current_pool = nullptr;
+	static thread_local size_t s_current_queue_idx = 0;
+
+	// Number of tasks being executed on the current thread,
+	// tasks can run other tasks while they wait for them.
+	static thread_local size_t s_running_task_depth = 0;
+
+	static void run_task(YosenTaskPool::task_t& task)
+	{
+		++s_running_task_depth;
+		task();
+		--s_running_task_depth;
+	}
+
+	YosenTaskLatch::YosenTaskLatch(size_t count)
+		: m_count(count) {}
+
+	void YosenTaskLatch::count_down()
+	{
+		if (m_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_cv.notify_all();
+		}
+	}
+
+	bool YosenTaskLatch::is_done() const
+	{
+		return m_count.load(std::memory_order_acquire) == 0;
+	}
+
+	void YosenTaskLatch::wait()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_cv.wait(lock, [this]() { return is_done(); });
+	}
+
+	YosenTaskPool::YosenTaskPool(size_t worker_count)
+	{
+		if (!worker_count)
+			worker_count = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+		for (size_t i = 0; i < worker_count; ++i)
+			m_queues.push_back(std::make_unique<WorkerQueue>());
+
+		for (size_t i = 0; i < worker_count; ++i)
+			m_workers.emplace_back(&YosenTaskPool::worker_loop, this, i);
+	}
+
+	YosenTaskPool::~YosenTaskPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_sleep_mutex);
+			m_running = false;
+		}
+
+		m_sleep_cv.notify_all();
+
+		for (auto& worker : m_workers)
+			worker.join();
+	}
+
+	YosenTaskPool& YosenTaskPool::get()
+	{
+		// Intentionally leaked, the process may exit while tasks are still running
+		static auto s_shared_pool = []() {
+			// Worker count can be overriden with the YOSEN_WORKER_THREADS variable
+			size_t worker_count = 0;
+			if (auto worker_count_str = std::getenv("YOSEN_WORKER_THREADS"))
+				worker_count = static_cast<size_t>(std::max(std::atoi(worker_count_str), 0));
+
+			return new YosenTaskPool(worker_count);
+		}();
+
+		return *s_shared_pool;
+	}
+
+	void YosenTaskPool::submit(task_t task)
+	{
+		// Workers keep the tasks they spawn in their own queue
+		size_t queue_idx = (s_current_pool == this)
+			? s_current_queue_idx
+			: m_next_queue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+
+		auto& queue = *m_queues[queue_idx];
+		{
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			queue.tasks.push_back(std::move(task));
+		}
+
+		m_pending_tasks.fetch_add(1, std::memory_order_release);
+
+		// Wake up one of the idle workers
+		{
+			std::lock_guard<std::mutex> lock(m_sleep_mutex);
+		}
+		m_sleep_cv.notify_one();
+	}
+
+	bool YosenTaskPool::run_pending_task()
+	{
+		task_t task;
+
+		size_t queue_idx = (s_current_pool == this) ? s_current_queue_idx : m_queues.size();
+		if (!pop_task(queue_idx, task))
+			return false;
+
+		run_task(task);
+		return true;
+	}
+
+	bool YosenTaskPool::is_running_task()
+	{
+		return s_running_task_depth > 0;
+	}
+
+	void YosenTaskPool::wait(YosenTaskLatch& latch)
+	{
+		while (!latch.is_done())
+		{
+			// The remaining tasks are already being executed
+			if (!run_pending_task())
+			{
+				latch.wait();
+				break;
+			}
+		}
+	}
+
+	void YosenTaskPool::worker_loop(size_t queue_idx)
+	{
+		s_current_pool = this;
+		s_current_queue_idx = queue_idx;
+
+		task_t task;
+
+		while (true)
+		{
+			if (pop_task(queue_idx, task))
+			{
+				run_task(task);
+				task = nullptr;
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(m_sleep_mutex);
+			m_sleep_cv.wait(lock, [this]() {
+				return !m_running || m_pending_tasks.load(std::memory_order_acquire) > 0;
+			});
+
+			if (!m_running)
+				break;
+		}
+	}
+
+	bool YosenTaskPool::pop_task(size_t queue_idx, task_t& task)
+	{
+		if (!m_pending_tasks.load(std::memory_order_acquire))
+			return false;
+
+		// Newest task from the worker's own queue
+		if (queue_idx < m_queues.size())
+		{
+			auto& queue = *m_queues[queue_idx];
+			std::lock_guard<std::mutex> lock(queue.mutex);
+
+			if (!queue.tasks.empty())
+			{
+				task = std::move(queue.tasks.back());
+				queue.tasks.pop_back();
+
+				m_pending_tasks.fetch_sub(1, std::memory_order_relaxed);
+				return true;
+			}
+		}
+
+		// Oldest task from any other queue
+		for (size_t i = 1; i <= m_queues.size(); ++i)
+		{
+			auto& queue = *m_queues[(queue_idx + i) % m_queues.size()];
+			std::lock_guard<std::mutex> lock(queue.mutex);
+
+			if (!queue.tasks.empty())
+			{
+				task = std::move(queue.tasks.front());
+				queue.tasks.pop_front();
+
+				m_pending_tasks.fetch_sub(1, std::memory_order_relaxed);
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include <YosenCore.h>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+namespace yosen
+{
+	// Counts down the completion of a number of tasks
+	class YosenTaskLatch
+	{
+	public:
+		YOSENAPI YosenTaskLatch(size_t count);
+
+		// Marks one task as complete
+		YOSENAPI void count_down();
+
+		// Returns whether or not all the tasks are complete
+		YOSENAPI bool is_done() const;
+
+		// Blocks until all the tasks are complete
+		YOSENAPI void wait();
+
+	private:
+		std::atomic<size_t> m_count;
+
+		std::mutex m_mutex;
+		std::condition_variable m_cv;
+	};
+
+	// Work-stealing thread pool. Every worker owns a task queue, runs its own
+	// tasks in LIFO order and steals the oldest tasks of other workers when
+	// it runs out of work. Tasks submitted from outside of the pool are
+	// distributed over the worker queues in a round-robin order.
+	class YosenTaskPool
+	{
+	public:
+		using task_t = std::function<void()>;
+
+		// Starts the given number of workers, or one per hardware thread if zero
+		YOSENAPI YosenTaskPool(size_t worker_count = 0);
+		YOSENAPI ~YosenTaskPool();
+
+		YosenTaskPool(const YosenTaskPool&) = delete;
+		YosenTaskPool& operator=(const YosenTaskPool&) = delete;
+
+		// Returns the pool shared by the whole process
+		YOSENAPI static YosenTaskPool& get();
+
+		// Schedules a task to be executed by one of the workers
+		YOSENAPI void submit(task_t task);
+
+		// Executes one pending task on the calling thread,
+		// returns false if there were no pending tasks.
+		YOSENAPI bool run_pending_task();
+
+		// Waits for the latch while helping with the pending tasks,
+		// this way tasks can wait for other tasks without deadlocking.
+		YOSENAPI void wait(YosenTaskLatch& latch);
+
+		// Returns the number of worker threads
+		inline size_t worker_count() const { return m_workers.size(); }
+
+		// Returns whether or not the calling thread is executing a task,
+		// either as a worker or while helping in wait().
+		YOSENAPI static bool is_running_task();
+
+	private:
+		struct WorkerQueue
+		{
+			std::mutex mutex;
+			std::deque<task_t> tasks;
+		};
+
+		std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+		std::vector<std::thread> m_workers;
+
+		// Number of tasks in all the queues
+		std::atomic<size_t> m_pending_tasks = 0;
+
+		// Queue that receives the next task submitted from outside of the pool
+		std::atomic<size_t> m_next_queue = 0;
+
+		bool m_running = true;
+
+		// Idle workers sleep until new tasks are submitted
+		std::mutex m_sleep_mutex;
+		std::condition_variable m_sleep_cv;
+
+	private:
+		void worker_loop(size_t queue_idx);
+
+		// Pops a task from the back of the given queue or
+		// steals one from the front of any other queue.
+		bool pop_task(size_t queue_idx, task_t& task);
+	};
+}
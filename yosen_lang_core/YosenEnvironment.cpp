@@ -4,26 +4,66 @@ namespace yosen
 {
 	static std::unique_ptr<YosenEnvironment> s_env_instance = nullptr;
 
+	// Environment bound to the current thread
+	static thread_local YosenEnvironment* s_current_env = nullptr;
+
+	// Receives the exceptions thrown on the thread instead of the registered handlers
+	static thread_local exception_handler_t* s_thread_exception_handler = nullptr;
+
+	// Immortal objects are shared by all the environments and
+	// live for as long as at least one environment is alive.
+	static std::mutex s_immortal_objects_mutex;
+	static size_t s_live_environment_count = 0;
+
 	void YosenEnvironment::init()
 	{
 		// Create environment
 		if (!s_env_instance)
-			s_env_instance = std::make_unique<YosenEnvironment>();
+			s_env_instance = create();
 		else
 		{
 			throw "Yosen environment already initialized!";
 			return;
 		}
+	}
+
+	std::unique_ptr<YosenEnvironment> YosenEnvironment::create()
+	{
+		auto env = std::make_unique<YosenEnvironment>();
+		env->initialize();
+
+		return env;
+	}
 
-		// Initialize default objects
-		YosenObject_Null = allocate_object<YosenObject>();
-		YosenObject_Null->m_string_repr = "null";
+	void YosenEnvironment::initialize()
+	{
+		{
+			std::lock_guard<std::mutex> lock(s_immortal_objects_mutex);
+
+			// Initialize default immortal objects, these are shared
+			// by all native functions and never get deallocated.
+			if (s_live_environment_count++ == 0)
+			{
+				YosenObject_Null = new YosenObject();
+				YosenObject_Null->m_string_repr = "null";
+				YosenObject_Null->m_immortal = true;
+
+				YosenObject_True = new YosenBoolean(true);
+				YosenObject_True->m_immortal = true;
+
+				YosenObject_False = new YosenBoolean(false);
+				YosenObject_False->m_immortal = true;
+			}
+		}
+
+		// Native functions register themselves into the current environment
+		YosenEnvironmentScope env_scope(this);
 
 		// Initialize macro functions such as "typeof()"
-		s_env_instance->initialize_macro_functions();
+		initialize_macro_functions();
 
 		// Initialize casting to primitive types
-		s_env_instance->initialize_primitive_casting_functions();
+		initialize_primitive_casting_functions();
 
 #if (YOSEN_INTERPRETER_DEBUG_MODE == 1)
 		utils::log_colored(
@@ -65,14 +105,46 @@ namespace yosen
 		for (auto& [name, key_obj_pair] : m_global_variable_objects)
 			free_object(key_obj_pair.second);
 
-		free_object(YosenObject_Null);
+		std::lock_guard<std::mutex> lock(s_immortal_objects_mutex);
+
+		// Destroy the immortal objects once the last environment is gone
+		if (--s_live_environment_count == 0)
+		{
+			delete YosenObject_Null;
+			delete YosenObject_True;
+			delete YosenObject_False;
+		}
 	}
 
 	YosenEnvironment& YosenEnvironment::get()
 	{
+		if (s_current_env)
+			return *s_current_env;
+
 		return *s_env_instance.get();
 	}
 
+	YosenEnvironment* YosenEnvironment::make_current(YosenEnvironment* env)
+	{
+		auto previous_env = s_current_env;
+		s_current_env = env;
+
+		return previous_env;
+	}
+
+	exception_handler_t* YosenEnvironment::set_thread_exception_handler(exception_handler_t* handler)
+	{
+		auto previous_handler = s_thread_exception_handler;
+		s_thread_exception_handler = handler;
+
+		return previous_handler;
+	}
+
+	exception_handler_t* YosenEnvironment::get_thread_exception_handler()
+	{
+		return s_thread_exception_handler;
+	}
+
 	void YosenEnvironment::register_static_native_function(const std::string& name, ys_static_native_fn_t fn)
 	{
 		// Apply current namespace name to the function's name
@@ -125,6 +197,10 @@ namespace yosen
 	
 	bool YosenEnvironment::load_yosen_module(const std::string& name)
 	{
+		// Modules are only loaded and initialized once
+		if (m_loaded_modules.find(name) != m_loaded_modules.end())
+			return true;
+
 		// Load module library
 		void* lib = utils::load_library(name.c_str());
 		if (!lib)
@@ -148,6 +224,7 @@ namespace yosen
 		// Initialize module
 		init_fn();
 
+		m_loaded_modules[name] = lib;
 		return true;
 	}
 	
@@ -165,14 +242,14 @@ namespace yosen
 		return m_custom_class_builders.find(name) != m_custom_class_builders.end();
 	}
 
-	YosenObject* YosenEnvironment::construct_class_instance(const std::string& name, YosenObject* args)
+	YosenObject* YosenEnvironment::construct_class_instance(const std::string& name, YosenArgs args)
 	{
 		if (m_custom_class_builders.find(name) != m_custom_class_builders.end())
 			return (m_custom_class_builders.at(name))(args);
 		else
 		{
 			printf("Class not found for '%s'\n", name.c_str());
-			return YosenObject_Null->clone();
+			return YosenObject_Null;
 		}
 	}
 
@@ -216,6 +293,15 @@ namespace yosen
 		return m_global_variable_objects.at(name).first;
 	}
 
+	std::string YosenEnvironment::get_global_variable_name(uint32_t key)
+	{
+		for (auto& [name, key_obj_pair] : m_global_variable_objects)
+			if (key_obj_pair.first == key)
+				return name;
+
+		return "";
+	}
+
 	void YosenEnvironment::set_global_variable(const std::string& name, YosenObject* value)
 	{
 		if (is_global_variable(name))
@@ -229,6 +315,25 @@ namespace yosen
 				key_obj_pair.second = value;
 	}
 
+	YosenObject* YosenEnvironment::clone_global_variable(uint32_t key)
+	{
+		std::lock_guard<std::mutex> lock(m_global_variables_mutex);
+		return get_global_variable(key)->clone();
+	}
+
+	void YosenEnvironment::store_global_variable(uint32_t key, YosenObject* value)
+	{
+		auto new_object = value->clone();
+
+		std::lock_guard<std::mutex> lock(m_global_variables_mutex);
+
+		auto original_object = get_global_variable(key);
+		set_global_variable(key, new_object);
+
+		m_global_variables_version.fetch_add(1, std::memory_order_release);
+		free_object(original_object);
+	}
+
 	void YosenEnvironment::start_module_namespace(const std::string& name)
 	{
 		if (m_current_module_namespace.empty())
@@ -253,6 +358,14 @@ namespace yosen
 
 	void YosenEnvironment::throw_exception(const YosenException& ex)
 	{
+		if (s_thread_exception_handler)
+		{
+			(*s_thread_exception_handler)(ex);
+			return;
+		}
+
+		std::lock_guard<std::recursive_mutex> lock(m_exception_mutex);
+
 		for (auto& listener : m_exception_handlers)
 			listener(ex);
 	}
@@ -261,108 +374,117 @@ namespace yosen
 	{
 		throw_exception(YosenException(reason));
 	}
+
+	void YosenEnvironment::register_execution_context_factory(ys_execution_context_factory_t factory)
+	{
+		m_execution_context_factory = factory;
+	}
+
+	std::unique_ptr<YosenExecutionContext> YosenEnvironment::create_execution_context()
+	{
+		if (!m_execution_context_factory)
+			return nullptr;
+
+		return m_execution_context_factory();
+	}
 	
 	void YosenEnvironment::initialize_primitive_casting_functions()
 	{
-		register_static_native_function("int", [](YosenObject* args) -> YosenObject* {
+		register_static_native_function("int", [](YosenArgs args) -> YosenObject* {
 			YosenObject* arg_object = nullptr;
-			arg_parse(args, "o", &arg_object);
-
-			if (!arg_object)
-				return YosenObject_Null->clone();
+			if (!arg_parse(args, arg_object))
+				return YosenObject_Null;
 
-			auto arg_type = arg_object->runtime_name();
-
-			if (strcmp(arg_type, "Integer") == 0)
+			if (arg_object->is<YosenInteger>())
 			{
-				return allocate_object<YosenInteger>(static_cast<YosenInteger*>(arg_object)->value);
+				return allocate_object<YosenInteger>(arg_object->as<YosenInteger>()->value);
 			}
-			else if (strcmp(arg_type, "Float") == 0)
+			else if (arg_object->is<YosenFloat>())
 			{
-				return allocate_object<YosenInteger>((int64_t)static_cast<YosenFloat*>(arg_object)->value);
+				return allocate_object<YosenInteger>((int64_t)arg_object->as<YosenFloat>()->value);
 			}
-			else if (strcmp(arg_type, "String") == 0)
+			else if (arg_object->is<YosenString>())
 			{
 				int64_t val = 0;
 				try {
-					val = (int64_t)std::stoi(static_cast<YosenString*>(arg_object)->value);
+					val = (int64_t)std::stoi(arg_object->as<YosenString>()->value);
 				}
 				catch (...) {
-					return YosenObject_Null->clone();
+					return YosenObject_Null;
 				}
 
 				return allocate_object<YosenInteger>(val);
 			}
-			else if (strcmp(arg_type, "Boolean") == 0)
+			else if (arg_object->is<YosenStringView>())
+			{
+				return arg_object->call_member_native_function("to_int", YosenArgs());
+			}
+			else if (arg_object->is<YosenBoolean>())
 			{
-				return allocate_object<YosenInteger>((int64_t)static_cast<YosenBoolean*>(arg_object)->value);
+				return allocate_object<YosenInteger>((int64_t)arg_object->as<YosenBoolean>()->value);
 			}
 
-			return YosenObject_Null->clone();
+			return YosenObject_Null;
 		});
 
-		register_static_native_function("float", [](YosenObject* args) -> YosenObject* {
+		register_static_native_function("float", [](YosenArgs args) -> YosenObject* {
 			YosenObject* arg_object = nullptr;
-			arg_parse(args, "o", &arg_object);
-
-			if (!arg_object)
-				return YosenObject_Null->clone();
+			if (!arg_parse(args, arg_object))
+				return YosenObject_Null;
 
-			auto arg_type = arg_object->runtime_name();
-
-			if (strcmp(arg_type, "Float") == 0)
+			if (arg_object->is<YosenFloat>())
 			{
-				return allocate_object<YosenFloat>(static_cast<YosenFloat*>(arg_object)->value);
+				return allocate_object<YosenFloat>(arg_object->as<YosenFloat>()->value);
 			}
-			else if (strcmp(arg_type, "Integer") == 0)
+			else if (arg_object->is<YosenInteger>())
 			{
-				return allocate_object<YosenFloat>((double)static_cast<YosenInteger*>(arg_object)->value);
+				return allocate_object<YosenFloat>((double)arg_object->as<YosenInteger>()->value);
 			}
-			else if (strcmp(arg_type, "String") == 0)
+			else if (arg_object->is<YosenString>())
 			{
 				double val = 0;
 				try {
-					val = std::stod(static_cast<YosenString*>(arg_object)->value);
+					val = std::stod(arg_object->as<YosenString>()->value);
 				}
 				catch (...) {
-					return YosenObject_Null->clone();
+					return YosenObject_Null;
 				}
 
 				return allocate_object<YosenFloat>(val);
 			}
-			else if (strcmp(arg_type, "Boolean") == 0)
+			else if (arg_object->is<YosenStringView>())
+			{
+				return arg_object->call_member_native_function("to_float", YosenArgs());
+			}
+			else if (arg_object->is<YosenBoolean>())
 			{
-				return allocate_object<YosenFloat>((double)static_cast<YosenBoolean*>(arg_object)->value);
+				return allocate_object<YosenFloat>((double)arg_object->as<YosenBoolean>()->value);
 			}
 			
-			return YosenObject_Null->clone();
+			return YosenObject_Null;
 		});
 
-		register_static_native_function("bool", [](YosenObject* args) -> YosenObject* {
+		register_static_native_function("bool", [](YosenArgs args) -> YosenObject* {
 			YosenObject* arg_object = nullptr;
-			arg_parse(args, "o", &arg_object);
-
-			if (!arg_object)
-				return YosenObject_Null->clone();
-
-			auto arg_type = arg_object->runtime_name();
+			if (!arg_parse(args, arg_object))
+				return YosenObject_Null;
 
-			if (strcmp(arg_type, "Boolean") == 0)
+			if (arg_object->is<YosenBoolean>())
 			{
-				return allocate_object<YosenBoolean>(static_cast<YosenBoolean*>(arg_object)->value);
+				return get_boolean_object(arg_object->as<YosenBoolean>()->value);
 			}
-			else if (strcmp(arg_type, "Integer") == 0)
+			else if (arg_object->is<YosenInteger>())
 			{
-				return allocate_object<YosenBoolean>((bool)static_cast<YosenInteger*>(arg_object)->value);
+				return get_boolean_object((bool)arg_object->as<YosenInteger>()->value);
 			}
-			else if (strcmp(arg_type, "Float") == 0)
+			else if (arg_object->is<YosenFloat>())
 			{
-				return allocate_object<YosenBoolean>((bool)static_cast<YosenFloat*>(arg_object)->value);
+				return get_boolean_object((bool)arg_object->as<YosenFloat>()->value);
 			}
-			else if (strcmp(arg_type, "String") == 0)
+			else if (arg_object->is<YosenString>())
 			{
 				bool val = false;
-				auto str_val = static_cast<YosenString*>(arg_object)->value;
+				auto str_val = arg_object->as<YosenString>()->value;
 
 				if (str_val == "true")
 					val = true;
@@ -370,21 +492,19 @@ namespace yosen
 					val = false;
 				else
 				{
-					return YosenObject_Null->clone();
+					return YosenObject_Null;
 				}
 
 				return allocate_object<YosenFloat>(val);
 			}
 
-			return YosenObject_Null->clone();
+			return YosenObject_Null;
 		});
 
-		register_static_native_function("str", [](YosenObject* args) -> YosenObject* {
+		register_static_native_function("str", [](YosenArgs args) -> YosenObject* {
 			YosenObject* arg_object = nullptr;
-			arg_parse(args, "o", &arg_object);
-
-			if (!arg_object)
-				return YosenObject_Null->clone();
+			if (!arg_parse(args, arg_object))
+				return YosenObject_Null;
 
 			return allocate_object<YosenString>(arg_object->to_string());
 		});
@@ -392,35 +512,29 @@ namespace yosen
 	
 	void YosenEnvironment::initialize_macro_functions()
 	{
-		register_static_native_function("typeof", [](YosenObject* args) -> YosenObject* {
+		register_static_native_function("typeof", [](YosenArgs args) -> YosenObject* {
 			YosenObject* arg_object = nullptr;
-			arg_parse(args, "o", &arg_object);
-
-			if (!arg_object)
-				return YosenObject_Null->clone();
+			if (!arg_parse(args, arg_object))
+				return YosenObject_Null;
 
 			return allocate_object<YosenString>(arg_object->runtime_name());
 		});
 
-		register_static_native_function("instanceof", [](YosenObject* args) -> YosenObject* {
+		register_static_native_function("instanceof", [](YosenArgs args) -> YosenObject* {
 			YosenObject* arg_object = nullptr;
-			arg_parse(args, "o", &arg_object);
-
-			if (!arg_object)
-				return YosenObject_Null->clone();
+			if (!arg_parse(args, arg_object))
+				return YosenObject_Null;
 
 			return allocate_object<YosenString>(arg_object->instance_info());
 		});
 
-		register_static_native_function("throw", [](YosenObject* args) -> YosenObject* {
-			char* ex_reason = nullptr;
-			arg_parse(args, "s", &ex_reason);
-
-			if (!ex_reason)
-				return YosenObject_Null->clone();
+		register_static_native_function("throw", [](YosenArgs args) -> YosenObject* {
+			std::string ex_reason;
+			if (!arg_parse(args, ex_reason))
+				return YosenObject_Null;
 
 			YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
-			return YosenObject_Null->clone();
+			return YosenObject_Null;
 		});
 	}
 }
@@ -3,6 +3,9 @@
 #include "StackFrame.h"
 #include "RuntimeClassBuilder.h"
 #include "YosenException.h"
+#include "ExecutionContext.h"
+#include "TaskPool.h"
+#include <mutex>
 
 // Primitive Types
 #include <primitives/primitives.h>
@@ -14,16 +17,46 @@ namespace yosen
 	class YosenEnvironment
 	{
 	public:
+		// Initializes the default process-wide environment
 		YOSENAPI static void init();
+
+		// Creates a new environment that is isolated from all the other ones,
+		// with its own functions, classes, global variables and loaded modules.
+		YOSENAPI static std::unique_ptr<YosenEnvironment> create();
+
 		YOSENAPI void shutdown();
+
+		// Returns the environment bound to the calling thread,
+		// or the default environment if no environment is bound.
 		YOSENAPI static YosenEnvironment& get();
 
+		// Binds the environment to the calling thread and
+		// returns the previously bound environment.
+		YOSENAPI static YosenEnvironment* make_current(YosenEnvironment* env);
+
+		// Sets the handler that receives the exceptions thrown on the calling
+		// thread instead of the registered exception handlers and returns the
+		// previously set handler. Passing nullptr restores the registered handlers.
+		YOSENAPI static exception_handler_t* set_thread_exception_handler(exception_handler_t* handler);
+
+		// Returns the exception handler set for the calling thread, or nullptr if none is set
+		YOSENAPI static exception_handler_t* get_thread_exception_handler();
+
 		YOSENAPI
 		void register_static_native_function(
 			const std::string& name,
 			ys_static_native_fn_t fn
 		);
 
+		// Registers a plain C++ function as a static native function,
+		// argument and return types are deduced from its signature.
+		// Example: env.register_native<&gen_int_range>("gen_int_range");
+		template <auto Fn>
+		inline void register_native(const std::string& name)
+		{
+			register_static_native_function(name, &ys_native_binding<decltype(Fn)>::template invoke<Fn>);
+		}
+
 		YOSENAPI
 		bool is_static_native_function(
 			const std::string& name
@@ -69,7 +102,7 @@ namespace yosen
 		YOSENAPI
 		YosenObject* construct_class_instance(
 			const std::string& name,
-			YosenObject* args
+			YosenArgs args
 		);
 
 		YOSENAPI
@@ -103,6 +136,13 @@ namespace yosen
 			const std::string& name
 		);
 
+		// Returns the name of the global variable with the given
+		// index, or an empty string if there's no such variable.
+		YOSENAPI
+		std::string get_global_variable_name(
+			uint32_t key
+		);
+
 		YOSENAPI
 		void set_global_variable(
 			const std::string& name,
@@ -115,6 +155,24 @@ namespace yosen
 			YosenObject* value
 		);
 
+		// Returns a copy of the global variable that is owned by the caller,
+		// safe to call while another thread stores the global variable.
+		YOSENAPI
+		YosenObject* clone_global_variable(
+			uint32_t key
+		);
+
+		// Replaces the global variable with a copy of the value and frees
+		// the previous one, synchronized with clone_global_variable().
+		YOSENAPI
+		void store_global_variable(
+			uint32_t key,
+			YosenObject* value
+		);
+
+		// Returns a counter that changes whenever a global variable is stored
+		inline uint64_t get_global_variables_version() const { return m_global_variables_version.load(std::memory_order_acquire); }
+
 		YOSENAPI
 		void start_module_namespace(
 			const std::string& name
@@ -138,7 +196,20 @@ namespace yosen
 			const std::string& reason
 		);
 
+		// Sets the function that creates execution contexts,
+		// registered by the interpreter running the environment.
+		YOSENAPI
+		void register_execution_context_factory(
+			ys_execution_context_factory_t factory
+		);
+
+		// Creates a new context for calling runtime functions on the
+		// calling thread, returns nullptr if no interpreter is available.
+		YOSENAPI
+		std::unique_ptr<YosenExecutionContext> create_execution_context();
+
 	private:
+		void initialize();
 		void initialize_primitive_casting_functions();
 		void initialize_macro_functions();
 
@@ -154,8 +225,55 @@ namespace yosen
 
 		std::map<std::string, std::pair<uint32_t, YosenObject*>> m_global_variable_objects;
 
+		// Handles of the native modules that were already loaded and initialized
+		std::map<std::string, void*> m_loaded_modules;
+
 	private:
 		// List of exception listeners
 		std::vector<exception_handler_t> m_exception_handlers;
+
+		// Creates contexts for executing runtime functions from native code
+		ys_execution_context_factory_t m_execution_context_factory = nullptr;
+
+		// Serializes exceptions thrown from multiple threads
+		std::recursive_mutex m_exception_mutex;
+
+		// Guards the global variable objects that are copied by other threads
+		std::mutex m_global_variables_mutex;
+		std::atomic<uint64_t> m_global_variables_version = 0;
+	};
+
+	// Binds an environment to the calling thread for the
+	// lifetime of the scope and restores the previous one after.
+	class YosenEnvironmentScope
+	{
+	public:
+		inline YosenEnvironmentScope(YosenEnvironment* env)
+			: m_previous_env(YosenEnvironment::make_current(env)) {}
+
+		inline ~YosenEnvironmentScope() { YosenEnvironment::make_current(m_previous_env); }
+
+		YosenEnvironmentScope(const YosenEnvironmentScope&) = delete;
+		YosenEnvironmentScope& operator=(const YosenEnvironmentScope&) = delete;
+
+	private:
+		YosenEnvironment* m_previous_env;
+	};
+
+	// Sets the thread's exception handler for the lifetime
+	// of the scope and restores the previous one after.
+	class YosenExceptionHandlerScope
+	{
+	public:
+		inline YosenExceptionHandlerScope(exception_handler_t* handler)
+			: m_previous_handler(YosenEnvironment::set_thread_exception_handler(handler)) {}
+
+		inline ~YosenExceptionHandlerScope() { YosenEnvironment::set_thread_exception_handler(m_previous_handler); }
+
+		YosenExceptionHandlerScope(const YosenExceptionHandlerScope&) = delete;
+		YosenExceptionHandlerScope& operator=(const YosenExceptionHandlerScope&) = delete;
+
+	private:
+		exception_handler_t* m_previous_handler;
 	};
 }
@@ -0,0 +1,188 @@
+#include "AllocationStats.h"
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+namespace yosen
+{
+	// Threads publish their live byte count to the shared
+	// peak tracker only after it changes by this many bytes.
+	constexpr int64_t PeakFlushThreshold = 16 * 1024;
+
+	// Allocation counters owned by a single thread. Only the owning
+	// thread writes to them, the atomics just make aggregation safe,
+	// so updates are plain relaxed loads and stores without locking.
+	struct ThreadAllocationCounters
+	{
+		std::array<std::atomic<int64_t>, ObjectTypeCount> live_objects = {};
+		std::array<std::atomic<int64_t>, ObjectTypeCount> live_shallow_bytes = {};
+		std::atomic<uint64_t> allocations = 0;
+
+		// Bytes allocated or freed since the last flush to the peak tracker
+		int64_t unflushed_bytes = 0;
+
+		ThreadAllocationCounters();
+		~ThreadAllocationCounters();
+	};
+
+	// All the counters of the running threads and
+	// the accumulated counters of the threads that exited.
+	struct AllocationCounterRegistry
+	{
+		std::mutex mutex;
+		std::vector<ThreadAllocationCounters*> thread_counters;
+
+		std::array<int64_t, ObjectTypeCount> retired_live_objects = {};
+		std::array<int64_t, ObjectTypeCount> retired_live_shallow_bytes = {};
+		uint64_t retired_allocations = 0;
+
+		std::atomic<int64_t> flushed_live_shallow_bytes = 0;
+		std::atomic<int64_t> peak_live_shallow_bytes = 0;
+	};
+
+	static AllocationCounterRegistry& get_allocation_counter_registry()
+	{
+		// Intentionally leaked, threads may exit after static destructors ran
+		static auto registry = new AllocationCounterRegistry();
+		return *registry;
+	}
+
+	static void flush_live_shallow_bytes(ThreadAllocationCounters& counters)
+	{
+		auto& registry = get_allocation_counter_registry();
+
+		auto live_shallow_bytes = registry.flushed_live_shallow_bytes.fetch_add(counters.unflushed_bytes, std::memory_order_relaxed) + counters.unflushed_bytes;
+		counters.unflushed_bytes = 0;
+
+		auto peak = registry.peak_live_shallow_bytes.load(std::memory_order_relaxed);
+		while (live_shallow_bytes > peak && !registry.peak_live_shallow_bytes.compare_exchange_weak(peak, live_shallow_bytes, std::memory_order_relaxed));
+	}
+
+	ThreadAllocationCounters::ThreadAllocationCounters()
+	{
+		auto& registry = get_allocation_counter_registry();
+
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		registry.thread_counters.push_back(this);
+	}
+
+	ThreadAllocationCounters::~ThreadAllocationCounters()
+	{
+		auto& registry = get_allocation_counter_registry();
+		flush_live_shallow_bytes(*this);
+
+		std::lock_guard<std::mutex> lock(registry.mutex);
+
+		// Objects may outlive the thread that allocated them
+		for (size_t i = 0; i < ObjectTypeCount; ++i)
+		{
+			registry.retired_live_objects[i] += live_objects[i].load(std::memory_order_relaxed);
+			registry.retired_live_shallow_bytes[i] += live_shallow_bytes[i].load(std::memory_order_relaxed);
+		}
+
+		registry.retired_allocations += allocations.load(std::memory_order_relaxed);
+
+		auto& counters = registry.thread_counters;
+		counters.erase(std::remove(counters.begin(), counters.end(), this), counters.end());
+	}
+
+	static thread_local ThreadAllocationCounters s_thread_allocation_counters;
+
+	template <typename T>
+	static inline void add_relaxed(std::atomic<T>& counter, T value)
+	{
+		counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+	}
+
+	void __yosen_register_allocated_object(YosenObject* obj, size_t size)
+	{
+		auto& counters = s_thread_allocation_counters;
+		auto type_idx = static_cast<size_t>(obj->m_type);
+
+		obj->m_allocation_size = static_cast<uint32_t>(size);
+
+		add_relaxed<int64_t>(counters.live_objects[type_idx], 1);
+		add_relaxed<int64_t>(counters.live_shallow_bytes[type_idx], size);
+		add_relaxed<uint64_t>(counters.allocations, 1);
+
+		counters.unflushed_bytes += size;
+		if (counters.unflushed_bytes >= PeakFlushThreshold)
+			flush_live_shallow_bytes(counters);
+	}
+
+	void __yosen_register_freed_object(YosenObject* obj)
+	{
+		// Objects that weren't created with allocate_object aren't tracked
+		if (!obj->m_allocation_size)
+			return;
+
+		auto& counters = s_thread_allocation_counters;
+		auto type_idx = static_cast<size_t>(obj->m_type);
+
+		add_relaxed<int64_t>(counters.live_objects[type_idx], -1);
+		add_relaxed<int64_t>(counters.live_shallow_bytes[type_idx], -static_cast<int64_t>(obj->m_allocation_size));
+
+		counters.unflushed_bytes -= obj->m_allocation_size;
+		if (counters.unflushed_bytes <= -PeakFlushThreshold)
+			flush_live_shallow_bytes(counters);
+	}
+
+	uint64_t __yosen_get_total_allocated_objects()
+	{
+		return get_allocation_stats().total_live_objects;
+	}
+
+	uint64_t get_thread_allocation_count()
+	{
+		return s_thread_allocation_counters.allocations.load(std::memory_order_relaxed);
+	}
+
+	YosenAllocationStats get_allocation_stats()
+	{
+		auto& registry = get_allocation_counter_registry();
+
+		std::array<int64_t, ObjectTypeCount> live_objects;
+		std::array<int64_t, ObjectTypeCount> live_shallow_bytes;
+		uint64_t allocations;
+
+		{
+			std::lock_guard<std::mutex> lock(registry.mutex);
+
+			live_objects = registry.retired_live_objects;
+			live_shallow_bytes = registry.retired_live_shallow_bytes;
+			allocations = registry.retired_allocations;
+
+			for (auto counters : registry.thread_counters)
+			{
+				for (size_t i = 0; i < ObjectTypeCount; ++i)
+				{
+					live_objects[i] += counters->live_objects[i].load(std::memory_order_relaxed);
+					live_shallow_bytes[i] += counters->live_shallow_bytes[i].load(std::memory_order_relaxed);
+				}
+
+				allocations += counters->allocations.load(std::memory_order_relaxed);
+			}
+		}
+
+		YosenAllocationStats stats;
+		stats.total_allocations = allocations;
+
+		// An object freed by a different thread than the one that allocated it
+		// makes the per-thread counters go negative, only the sums are meaningful.
+		for (size_t i = 0; i < ObjectTypeCount; ++i)
+		{
+			stats.live_objects[i] = static_cast<uint64_t>(std::max<int64_t>(live_objects[i], 0));
+			stats.live_shallow_bytes[i] = static_cast<uint64_t>(std::max<int64_t>(live_shallow_bytes[i], 0));
+
+			stats.total_live_objects += stats.live_objects[i];
+			stats.total_live_shallow_bytes += stats.live_shallow_bytes[i];
+		}
+
+		// The exact total might be above the batched peak
+		auto peak = registry.peak_live_shallow_bytes.load(std::memory_order_relaxed);
+		stats.peak_live_shallow_bytes = std::max<uint64_t>(static_cast<uint64_t>(std::max<int64_t>(peak, 0)), stats.total_live_shallow_bytes);
+
+		return stats;
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include "YosenObject.h"
+#include <array>
+
+namespace yosen
+{
+	constexpr size_t ObjectTypeCount = static_cast<size_t>(ObjectType::Count);
+
+	// Snapshot of the object allocations made by all threads.
+	// Counters are kept per thread and only aggregated when requested,
+	// so taking a snapshot never slows down allocations.
+	//
+	// Byte counts are shallow, they only include the size of the object
+	// itself and not the memory it owns, such as string or list buffers.
+	struct YosenAllocationStats
+	{
+		// Number of live objects of each type, indexed by ObjectType
+		std::array<uint64_t, ObjectTypeCount> live_objects = {};
+
+		// Shallow bytes used by the live objects of each type, indexed by ObjectType
+		std::array<uint64_t, ObjectTypeCount> live_shallow_bytes = {};
+
+		uint64_t total_live_objects = 0;
+		uint64_t total_live_shallow_bytes = 0;
+
+		// Number of objects allocated since the start of the process
+		uint64_t total_allocations = 0;
+
+		// Highest number of live shallow bytes reached, threads report their usage
+		// in batches so the value may lag behind by a few kilobytes per thread.
+		uint64_t peak_live_shallow_bytes = 0;
+	};
+
+	// Aggregates the allocation counters of all threads
+	YOSENAPI YosenAllocationStats get_allocation_stats();
+
+	// Returns the number of objects allocated by the calling thread,
+	// cheap enough to be sampled around individual operations.
+	YOSENAPI uint64_t get_thread_allocation_count();
+}
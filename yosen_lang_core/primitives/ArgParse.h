@@ -0,0 +1,138 @@
+#pragma once
+#include "YosenBoolean.h"
+#include "YosenInteger.h"
+#include "YosenFloat.h"
+#include "YosenString.h"
+#include "YosenStringView.h"
+#include <string_view>
+#include <type_traits>
+
+namespace yosen
+{
+	// Throws a runtime exception about an invalid number of native function arguments
+	YOSENAPI void __yosen_throw_arg_count_exception(size_t expected, size_t received);
+
+	// Throws a runtime exception about a native function argument of an unexpected type
+	YOSENAPI void __yosen_throw_arg_type_exception(size_t idx, ObjectType expected, YosenObject* received);
+
+	// Describes how a native argument of type T gets
+	// type-checked and extracted from a Yosen object.
+	template <typename T, typename = void>
+	struct ys_arg_traits;
+
+	template <typename T>
+	struct ys_arg_traits<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>>
+	{
+		static constexpr ObjectType type = ObjectType::Integer;
+
+		static inline bool check(YosenObject* obj) { return obj->is<YosenInteger>(); }
+		static inline T get(YosenObject* obj) { return static_cast<T>(obj->as<YosenInteger>()->value); }
+	};
+
+	template <typename T>
+	struct ys_arg_traits<T, std::enable_if_t<std::is_floating_point_v<T>>>
+	{
+		static constexpr ObjectType type = ObjectType::Float;
+
+		static inline bool check(YosenObject* obj) { return obj->is<YosenFloat>(); }
+		static inline T get(YosenObject* obj) { return static_cast<T>(obj->as<YosenFloat>()->value); }
+	};
+
+	template <>
+	struct ys_arg_traits<bool>
+	{
+		static constexpr ObjectType type = ObjectType::Boolean;
+
+		static inline bool check(YosenObject* obj) { return obj->is<YosenBoolean>(); }
+		static inline bool get(YosenObject* obj) { return obj->as<YosenBoolean>()->value; }
+	};
+
+	// String arguments reference the string object's buffer directly and are
+	// valid only during the call. String views are accepted without copying them.
+	template <>
+	struct ys_arg_traits<std::string_view>
+	{
+		static constexpr ObjectType type = ObjectType::String;
+
+		static inline bool check(YosenObject* obj) { return obj->is<YosenString>() || obj->is<YosenStringView>(); }
+
+		static inline std::string_view get(YosenObject* obj)
+		{
+			std::string_view value;
+			get_string_contents(obj, value);
+			return value;
+		}
+	};
+
+	template <>
+	struct ys_arg_traits<const char*>
+	{
+		static constexpr ObjectType type = ObjectType::String;
+
+		static inline bool check(YosenObject* obj) { return obj->is<YosenString>(); }
+		static inline const char* get(YosenObject* obj) { return obj->as<YosenString>()->value.c_str(); }
+	};
+
+	template <>
+	struct ys_arg_traits<std::string>
+	{
+		static constexpr ObjectType type = ObjectType::String;
+
+		static inline bool check(YosenObject* obj) { return obj->is<YosenString>(); }
+		static inline std::string get(YosenObject* obj) { return obj->as<YosenString>()->value; }
+	};
+
+	// Object arguments are passed by pointer, either as a generic
+	// YosenObject or as a specific type that has to match exactly.
+	template <typename T>
+	struct ys_arg_traits<T*, std::enable_if_t<std::is_base_of_v<YosenObject, T>>>
+	{
+		static constexpr ObjectType type = T::object_type;
+
+		static inline bool check(YosenObject* obj)
+		{
+			if constexpr (std::is_same_v<T, YosenObject>)
+				return true;
+			else
+				return obj->is<T>();
+		}
+
+		static inline T* get(YosenObject* obj) { return static_cast<T*>(obj); }
+	};
+
+	template <typename T>
+	inline bool __ys_check_arg(YosenArgs args, size_t idx)
+	{
+		if (ys_arg_traits<T>::check(args[idx]))
+			return true;
+
+		__yosen_throw_arg_type_exception(idx, ys_arg_traits<T>::type, args[idx]);
+		return false;
+	}
+
+	template <typename T>
+	inline bool __ys_extract_arg(YosenArgs args, size_t idx, T& out)
+	{
+		if (!__ys_check_arg<T>(args, idx))
+			return false;
+
+		out = ys_arg_traits<T>::get(args[idx]);
+		return true;
+	}
+
+	// Extracts and type-checks native function arguments into the given
+	// output variables. Conversions are resolved at compile time from the
+	// types of the output variables, returns false if the arguments don't match.
+	template <typename... Ts>
+	inline bool arg_parse(YosenArgs args, Ts&... out)
+	{
+		if (args.size() < sizeof...(Ts))
+		{
+			__yosen_throw_arg_count_exception(sizeof...(Ts), args.size());
+			return false;
+		}
+
+		[[maybe_unused]] size_t idx = 0;
+		return (__ys_extract_arg(args, idx++, out) && ...);
+	}
+}
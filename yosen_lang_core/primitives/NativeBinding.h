@@ -0,0 +1,67 @@
+#pragma once
+#include "ArgParse.h"
+#include <utility>
+
+namespace yosen
+{
+	template <typename T>
+	struct __ys_dependent_false : std::false_type {};
+
+	// Converts the return value of a bound C++ function into a Yosen object
+	template <typename T>
+	inline YosenObject* __ys_make_return_object(T&& value)
+	{
+		using type = std::decay_t<T>;
+
+		if constexpr (std::is_same_v<type, bool>)
+			return get_boolean_object(value);
+		else if constexpr (std::is_integral_v<type>)
+			return allocate_object<YosenInteger>(static_cast<int64_t>(value));
+		else if constexpr (std::is_floating_point_v<type>)
+			return allocate_object<YosenFloat>(static_cast<double>(value));
+		else if constexpr (std::is_convertible_v<type, std::string_view>)
+			return allocate_object<YosenString>(std::string(std::string_view(value)));
+		else if constexpr (std::is_pointer_v<type> && std::is_base_of_v<YosenObject, std::remove_pointer_t<type>>)
+			return value;
+		else
+			static_assert(__ys_dependent_false<type>::value, "Unsupported native function return type");
+	}
+
+	// Generates a native function thunk for a plain C++ function.
+	// Argument unpacking and return value conversion are resolved at
+	// compile time from the function's signature using ys_arg_traits.
+	template <typename Fn>
+	struct ys_native_binding;
+
+	template <typename R, typename... Args>
+	struct ys_native_binding<R(*)(Args...)>
+	{
+		template <R(*Fn)(Args...)>
+		static YosenObject* invoke(YosenArgs args)
+		{
+			if (args.size() != sizeof...(Args))
+			{
+				__yosen_throw_arg_count_exception(sizeof...(Args), args.size());
+				return nullptr;
+			}
+
+			return call<Fn>(args, std::index_sequence_for<Args...>{});
+		}
+
+	private:
+		template <R(*Fn)(Args...), size_t... Is>
+		static inline YosenObject* call([[maybe_unused]] YosenArgs args, std::index_sequence<Is...>)
+		{
+			if (!(__ys_check_arg<std::decay_t<Args>>(args, Is) && ...))
+				return nullptr;
+
+			if constexpr (std::is_void_v<R>)
+			{
+				Fn(ys_arg_traits<std::decay_t<Args>>::get(args[Is])...);
+				return YosenObject_Null;
+			}
+			else
+				return __ys_make_return_object(Fn(ys_arg_traits<std::decay_t<Args>>::get(args[Is])...));
+		}
+	};
+}
@@ -0,0 +1,532 @@
+#include "StringKernels.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+	#define YOSEN_STRING_KERNELS_X86 1
+	#include <immintrin.h>
+
+	#ifdef _MSC_VER
+		#include <intrin.h>
+		#define YOSEN_TARGET_AVX2
+	#else
+		#define YOSEN_TARGET_AVX2 __attribute__((target("avx2")))
+	#endif
+#endif
+
+namespace yosen::string_kernels
+{
+	// Kernels of a single instruction set. Searches return the size
+	// of the string if nothing was found, substring searches are
+	// only used for substrings at least two bytes long.
+	struct StringKernelTable
+	{
+		const char* isa;
+
+		size_t	(*find_byte)(const char* data, size_t size, char c);
+		size_t	(*count_byte)(const char* data, size_t size, char c);
+		size_t	(*find)(const char* data, size_t size, const char* substr, size_t substr_size);
+		void	(*to_upper)(char* data, size_t size);
+		void	(*to_lower)(char* data, size_t size);
+		bool	(*is_ascii)(const char* data, size_t size);
+	};
+
+	//
+	// Scalar
+	//
+	namespace scalar
+	{
+		static size_t find_byte(const char* data, size_t size, char c)
+		{
+			auto result = static_cast<const char*>(memchr(data, c, size));
+			return result ? static_cast<size_t>(result - data) : size;
+		}
+
+		static size_t count_byte(const char* data, size_t size, char c)
+		{
+			size_t count = 0;
+			for (size_t i = 0; i < size; ++i)
+				count += (data[i] == c);
+
+			return count;
+		}
+
+		static size_t find(const char* data, size_t size, const char* substr, size_t substr_size)
+		{
+			auto idx = std::string_view(data, size).find(std::string_view(substr, substr_size));
+			return (idx == std::string_view::npos) ? size : idx;
+		}
+
+		// Flips the case of the letters between first and first + 25
+		static inline void convert_case(char* data, size_t size, char first)
+		{
+			for (size_t i = 0; i < size; ++i)
+				data[i] ^= static_cast<char>((static_cast<unsigned char>(data[i] - first) < 26) << 5);
+		}
+
+		static void to_upper(char* data, size_t size) { convert_case(data, size, 'a'); }
+		static void to_lower(char* data, size_t size) { convert_case(data, size, 'A'); }
+
+		static bool is_ascii(const char* data, size_t size)
+		{
+			constexpr uint64_t high_bits = 0x8080808080808080ull;
+
+			size_t i = 0;
+			for (; i + 8 <= size; i += 8)
+			{
+				uint64_t word;
+				memcpy(&word, data + i, sizeof(word));
+
+				if (word & high_bits)
+					return false;
+			}
+
+			for (; i < size; ++i)
+				if (static_cast<unsigned char>(data[i]) & 0x80)
+					return false;
+
+			return true;
+		}
+
+		static const StringKernelTable kernels = {
+			"scalar", find_byte, count_byte, find, to_upper, to_lower, is_ascii
+		};
+	}
+
+#ifdef YOSEN_STRING_KERNELS_X86
+	static inline unsigned int count_trailing_zeros(uint32_t mask)
+	{
+#ifdef _MSC_VER
+		unsigned long idx;
+		_BitScanForward(&idx, mask);
+		return static_cast<unsigned int>(idx);
+#else
+		return static_cast<unsigned int>(__builtin_ctz(mask));
+#endif
+	}
+
+	// Signed byte comparisons only work on a range starting at -128, letters are
+	// shifted there so a single comparison checks both bounds of the range.
+	static inline char get_case_shift(char first)
+	{
+		return static_cast<char>(0x80 - static_cast<unsigned char>(first));
+	}
+
+	//
+	// SSE2, always available on x86-64
+	//
+	namespace sse2
+	{
+		static inline __m128i load(const char* data)
+		{
+			return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+		}
+
+		static size_t find_byte(const char* data, size_t size, char c)
+		{
+			const __m128i needle = _mm_set1_epi8(c);
+
+			size_t i = 0;
+			for (; i + 16 <= size; i += 16)
+			{
+				uint32_t mask = _mm_movemask_epi8(_mm_cmpeq_epi8(load(data + i), needle));
+				if (mask)
+					return i + count_trailing_zeros(mask);
+			}
+
+			for (; i < size; ++i)
+				if (data[i] == c)
+					return i;
+
+			return size;
+		}
+
+		static size_t count_byte(const char* data, size_t size, char c)
+		{
+			const __m128i needle = _mm_set1_epi8(c);
+
+			size_t count = 0;
+			size_t i = 0;
+
+			while (i + 16 <= size)
+			{
+				// Byte counters overflow after 255 blocks
+				size_t full_blocks_end = i + ((size - i) / 16) * 16;
+				size_t batch_end = std::min(full_blocks_end, i + 255 * 16);
+
+				__m128i counters = _mm_setzero_si128();
+				for (; i < batch_end; i += 16)
+					counters = _mm_sub_epi8(counters, _mm_cmpeq_epi8(load(data + i), needle));
+
+				__m128i sums = _mm_sad_epu8(counters, _mm_setzero_si128());
+				count += static_cast<size_t>(_mm_cvtsi128_si64(sums) + _mm_cvtsi128_si64(_mm_unpackhi_epi64(sums, sums)));
+			}
+
+			return count + scalar::count_byte(data + i, size - i, c);
+		}
+
+		// Compares the first and last bytes of the substring at 16 positions
+		// at once, only the candidates that match both are compared fully.
+		static size_t find(const char* data, size_t size, const char* substr, size_t substr_size)
+		{
+			const __m128i first = _mm_set1_epi8(substr[0]);
+			const __m128i last = _mm_set1_epi8(substr[substr_size - 1]);
+
+			size_t i = 0;
+			for (; i + substr_size - 1 + 16 <= size; i += 16)
+			{
+				__m128i first_matches = _mm_cmpeq_epi8(load(data + i), first);
+				__m128i last_matches = _mm_cmpeq_epi8(load(data + i + substr_size - 1), last);
+
+				uint32_t mask = _mm_movemask_epi8(_mm_and_si128(first_matches, last_matches));
+				while (mask)
+				{
+					auto candidate = i + count_trailing_zeros(mask);
+					if (memcmp(data + candidate + 1, substr + 1, substr_size - 2) == 0)
+						return candidate;
+
+					mask &= mask - 1;
+				}
+			}
+
+			auto idx = scalar::find(data + i, size - i, substr, substr_size);
+			return (idx == size - i) ? size : i + idx;
+		}
+
+		static inline void convert_case(char* data, size_t size, char first)
+		{
+			const __m128i shift = _mm_set1_epi8(get_case_shift(first));
+			const __m128i limit = _mm_set1_epi8(static_cast<char>(-128 + 26));
+			const __m128i case_bit = _mm_set1_epi8(0x20);
+
+			size_t i = 0;
+			for (; i + 16 <= size; i += 16)
+			{
+				__m128i block = load(data + i);
+				__m128i is_letter = _mm_cmplt_epi8(_mm_add_epi8(block, shift), limit);
+
+				block = _mm_xor_si128(block, _mm_and_si128(is_letter, case_bit));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), block);
+			}
+
+			scalar::convert_case(data + i, size - i, first);
+		}
+
+		static void to_upper(char* data, size_t size) { convert_case(data, size, 'a'); }
+		static void to_lower(char* data, size_t size) { convert_case(data, size, 'A'); }
+
+		static bool is_ascii(const char* data, size_t size)
+		{
+			__m128i combined = _mm_setzero_si128();
+
+			size_t i = 0;
+			for (; i + 16 <= size; i += 16)
+				combined = _mm_or_si128(combined, load(data + i));
+
+			return !_mm_movemask_epi8(combined) && scalar::is_ascii(data + i, size - i);
+		}
+
+		static const StringKernelTable kernels = {
+			"sse2", find_byte, count_byte, find, to_upper, to_lower, is_ascii
+		};
+	}
+
+	//
+	// AVX2
+	//
+	namespace avx2
+	{
+		YOSEN_TARGET_AVX2 static inline __m256i load(const char* data)
+		{
+			return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+		}
+
+		YOSEN_TARGET_AVX2 static size_t find_byte(const char* data, size_t size, char c)
+		{
+			const __m256i needle = _mm256_set1_epi8(c);
+
+			size_t i = 0;
+			for (; i + 32 <= size; i += 32)
+			{
+				uint32_t mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(load(data + i), needle));
+				if (mask)
+					return i + count_trailing_zeros(mask);
+			}
+
+			auto idx = sse2::find_byte(data + i, size - i, c);
+			return i + idx;
+		}
+
+		YOSEN_TARGET_AVX2 static size_t count_byte(const char* data, size_t size, char c)
+		{
+			const __m256i needle = _mm256_set1_epi8(c);
+
+			size_t count = 0;
+			size_t i = 0;
+
+			while (i + 32 <= size)
+			{
+				// Byte counters overflow after 255 blocks
+				size_t full_blocks_end = i + ((size - i) / 32) * 32;
+				size_t batch_end = std::min(full_blocks_end, i + 255 * 32);
+
+				__m256i counters = _mm256_setzero_si256();
+				for (; i < batch_end; i += 32)
+					counters = _mm256_sub_epi8(counters, _mm256_cmpeq_epi8(load(data + i), needle));
+
+				__m256i sums = _mm256_sad_epu8(counters, _mm256_setzero_si256());
+				count += static_cast<size_t>(
+					_mm256_extract_epi64(sums, 0) + _mm256_extract_epi64(sums, 1) +
+					_mm256_extract_epi64(sums, 2) + _mm256_extract_epi64(sums, 3)
+				);
+			}
+
+			return count + sse2::count_byte(data + i, size - i, c);
+		}
+
+		YOSEN_TARGET_AVX2 static size_t find(const char* data, size_t size, const char* substr, size_t substr_size)
+		{
+			const __m256i first = _mm256_set1_epi8(substr[0]);
+			const __m256i last = _mm256_set1_epi8(substr[substr_size - 1]);
+
+			size_t i = 0;
+			for (; i + substr_size - 1 + 32 <= size; i += 32)
+			{
+				__m256i first_matches = _mm256_cmpeq_epi8(load(data + i), first);
+				__m256i last_matches = _mm256_cmpeq_epi8(load(data + i + substr_size - 1), last);
+
+				uint32_t mask = _mm256_movemask_epi8(_mm256_and_si256(first_matches, last_matches));
+				while (mask)
+				{
+					auto candidate = i + count_trailing_zeros(mask);
+					if (memcmp(data + candidate + 1, substr + 1, substr_size - 2) == 0)
+						return candidate;
+
+					mask &= mask - 1;
+				}
+			}
+
+			auto idx = sse2::find(data + i, size - i, substr, substr_size);
+			return i + idx;
+		}
+
+		YOSEN_TARGET_AVX2 static inline void convert_case(char* data, size_t size, char first)
+		{
+			const __m256i shift = _mm256_set1_epi8(get_case_shift(first));
+			const __m256i limit = _mm256_set1_epi8(static_cast<char>(-128 + 26));
+			const __m256i case_bit = _mm256_set1_epi8(0x20);
+
+			size_t i = 0;
+			for (; i + 32 <= size; i += 32)
+			{
+				__m256i block = load(data + i);
+				__m256i is_letter = _mm256_cmpgt_epi8(limit, _mm256_add_epi8(block, shift));
+
+				block = _mm256_xor_si256(block, _mm256_and_si256(is_letter, case_bit));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i), block);
+			}
+
+			sse2::convert_case(data + i, size - i, first);
+		}
+
+		YOSEN_TARGET_AVX2 static void to_upper(char* data, size_t size) { convert_case(data, size, 'a'); }
+		YOSEN_TARGET_AVX2 static void to_lower(char* data, size_t size) { convert_case(data, size, 'A'); }
+
+		YOSEN_TARGET_AVX2 static bool is_ascii(const char* data, size_t size)
+		{
+			__m256i combined = _mm256_setzero_si256();
+
+			size_t i = 0;
+			for (; i + 32 <= size; i += 32)
+				combined = _mm256_or_si256(combined, load(data + i));
+
+			return !_mm256_movemask_epi8(combined) && sse2::is_ascii(data + i, size - i);
+		}
+
+		static const StringKernelTable kernels = {
+			"avx2", find_byte, count_byte, find, to_upper, to_lower, is_ascii
+		};
+	}
+
+	static bool cpu_supports_avx2()
+	{
+#ifdef _MSC_VER
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return false;
+
+		// The OS has to save the AVX registers on context switches
+		__cpuid(info, 1);
+		bool has_osxsave = info[2] & (1 << 27);
+		bool has_avx = info[2] & (1 << 28);
+
+		if (!has_osxsave || !has_avx || (_xgetbv(0) & 0x6) != 0x6)
+			return false;
+
+		__cpuidex(info, 7, 0);
+		return info[1] & (1 << 5);
+#else
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2");
+#endif
+	}
+#endif // YOSEN_STRING_KERNELS_X86
+
+	static const StringKernelTable& select_kernels()
+	{
+		std::string_view forced_isa;
+		if (auto isa_str = std::getenv("YOSEN_STRING_KERNELS"))
+			forced_isa = isa_str;
+
+		if (forced_isa == "scalar")
+			return scalar::kernels;
+
+#ifdef YOSEN_STRING_KERNELS_X86
+		if (forced_isa == "sse2")
+			return sse2::kernels;
+
+		if (cpu_supports_avx2())
+			return avx2::kernels;
+
+		return sse2::kernels;
+#else
+		return scalar::kernels;
+#endif
+	}
+
+	static inline const StringKernelTable& get_kernels()
+	{
+		static const StringKernelTable& s_kernels = select_kernels();
+		return s_kernels;
+	}
+
+	const char* get_active_isa()
+	{
+		return get_kernels().isa;
+	}
+
+	size_t find_byte(std::string_view str, char c, size_t start)
+	{
+		if (start >= str.size())
+			return std::string_view::npos;
+
+		auto idx = get_kernels().find_byte(str.data() + start, str.size() - start, c);
+		return (idx == str.size() - start) ? std::string_view::npos : start + idx;
+	}
+
+	size_t find(std::string_view str, std::string_view substr, size_t start)
+	{
+		if (substr.size() <= 1)
+			return substr.empty() ? (start <= str.size() ? start : std::string_view::npos) : find_byte(str, substr[0], start);
+
+		if (start >= str.size() || str.size() - start < substr.size())
+			return std::string_view::npos;
+
+		auto size = str.size() - start;
+		auto idx = get_kernels().find(str.data() + start, size, substr.data(), substr.size());
+
+		return (idx == size) ? std::string_view::npos : start + idx;
+	}
+
+	size_t count_byte(std::string_view str, char c)
+	{
+		return get_kernels().count_byte(str.data(), str.size(), c);
+	}
+
+	size_t count(std::string_view str, std::string_view substr)
+	{
+		if (substr.empty())
+			return 0;
+
+		if (substr.size() == 1)
+			return count_byte(str, substr[0]);
+
+		size_t count = 0;
+		for (size_t idx = find(str, substr); idx != std::string_view::npos; idx = find(str, substr, idx + substr.size()))
+			++count;
+
+		return count;
+	}
+
+	std::vector<std::string_view> split(std::string_view str, std::string_view separator)
+	{
+		std::vector<std::string_view> parts;
+		if (separator.empty())
+		{
+			parts.push_back(str);
+			return parts;
+		}
+
+		size_t pos = 0;
+		while (true)
+		{
+			size_t end = find(str, separator, pos);
+			if (end == std::string_view::npos)
+			{
+				parts.push_back(str.substr(pos));
+				return parts;
+			}
+
+			parts.push_back(str.substr(pos, end - pos));
+			pos = end + separator.size();
+		}
+	}
+
+	std::vector<std::string_view> split_whitespace(std::string_view str)
+	{
+		constexpr std::string_view whitespace = " \t\r\n\v\f";
+
+		std::vector<std::string_view> parts;
+		size_t pos = str.find_first_not_of(whitespace);
+
+		while (pos != std::string_view::npos)
+		{
+			size_t end = str.find_first_of(whitespace, pos);
+			if (end == std::string_view::npos)
+				end = str.size();
+
+			parts.push_back(str.substr(pos, end - pos));
+			pos = str.find_first_not_of(whitespace, end);
+		}
+
+		return parts;
+	}
+
+	std::string replace_all(std::string_view str, std::string_view from, std::string_view to)
+	{
+		if (from.empty())
+			return std::string(str);
+
+		std::string result;
+		result.reserve(str.size());
+
+		size_t pos = 0;
+		for (size_t idx = find(str, from); idx != std::string_view::npos; idx = find(str, from, pos))
+		{
+			result.append(str.data() + pos, idx - pos);
+			result.append(to);
+			pos = idx + from.size();
+		}
+
+		result.append(str.data() + pos, str.size() - pos);
+		return result;
+	}
+
+	void to_upper(std::string& str)
+	{
+		get_kernels().to_upper(str.data(), str.size());
+	}
+
+	void to_lower(std::string& str)
+	{
+		get_kernels().to_lower(str.data(), str.size());
+	}
+
+	bool is_ascii(std::string_view str)
+	{
+		return get_kernels().is_ascii(str.data(), str.size());
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <YosenCore.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Vectorized string search and transformation routines used by the string primitives.
+// The implementation is picked once at runtime from the instruction sets supported
+// by the CPU (AVX2, SSE2 or portable scalar code), the YOSEN_STRING_KERNELS
+// variable can be set to "avx2", "sse2" or "scalar" to force one of them.
+namespace yosen::string_kernels
+{
+	// Returns the name of the instruction set used by the kernels
+	YOSENAPI const char* get_active_isa();
+
+	// Returns the index of the first occurrence of the byte at or after the start index, or npos
+	YOSENAPI size_t find_byte(std::string_view str, char c, size_t start = 0);
+
+	// Returns the index of the first occurrence of the substring at or after the start index, or npos
+	YOSENAPI size_t find(std::string_view str, std::string_view substr, size_t start = 0);
+
+	// Returns the number of times the byte occurs in the string
+	YOSENAPI size_t count_byte(std::string_view str, char c);
+
+	// Returns the number of non-overlapping occurrences of a non-empty substring
+	YOSENAPI size_t count(std::string_view str, std::string_view substr);
+
+	// Splits the string around every occurrence of a non-empty separator,
+	// the parts reference the original string's buffer.
+	YOSENAPI std::vector<std::string_view> split(std::string_view str, std::string_view separator);
+
+	// Splits the string on runs of ASCII whitespace, empty parts are skipped
+	YOSENAPI std::vector<std::string_view> split_whitespace(std::string_view str);
+
+	// Returns a copy of the string with every non-overlapping
+	// occurrence of a non-empty substring replaced.
+	YOSENAPI std::string replace_all(std::string_view str, std::string_view from, std::string_view to);
+
+	// Converts ASCII letters in place, other bytes are left unchanged
+	YOSENAPI void to_upper(std::string& str);
+	YOSENAPI void to_lower(std::string& str);
+
+	// Returns whether or not every byte of the string is 7-bit ASCII
+	YOSENAPI bool is_ascii(std::string_view str);
+}
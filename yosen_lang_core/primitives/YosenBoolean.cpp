@@ -3,20 +3,21 @@
 
 namespace yosen
 {
-	YosenBoolean::YosenBoolean()
+	YosenBoolean::YosenBoolean() : YosenObject(object_type)
 	{
-		register_runtime_operator_functions();
+		m_runtime_operator_table = &s_runtime_operator_functions;
 	}
 
-	YosenBoolean::YosenBoolean(bool val) : value(val)
+	YosenBoolean::YosenBoolean(bool val) : YosenObject(object_type), value(val)
 	{
-		register_runtime_operator_functions();
+		m_runtime_operator_table = &s_runtime_operator_functions;
 	}
 	
 	YosenObject* YosenBoolean::clone()
 	{
-		auto new_obj = allocate_object<YosenBoolean>(this->value);
-		return new_obj;
+		// Booleans are never copied, the shared
+		// immortal true and false objects are used instead.
+		return get_boolean_object(this->value);
 	}
 	
 	std::string YosenBoolean::to_string()
@@ -29,103 +30,102 @@ namespace yosen
 		return "Boolean";
 	}
 
-	void YosenBoolean::register_runtime_operator_functions()
-	{
-		add_runtime_operator_function(RuntimeOperator::BoolOpEqu,			MEMBER_FUNCTION(operator_equ));
-		add_runtime_operator_function(RuntimeOperator::BoolOpNotEqu,		MEMBER_FUNCTION(operator_notequ));
-		add_runtime_operator_function(RuntimeOperator::BoolOpGreaterThan,	MEMBER_FUNCTION(operator_greater));
-		add_runtime_operator_function(RuntimeOperator::BoolOpLessThan,		MEMBER_FUNCTION(operator_less));
-		add_runtime_operator_function(RuntimeOperator::BoolOpOr,			MEMBER_FUNCTION(operator_or));
-		add_runtime_operator_function(RuntimeOperator::BoolOpAnd,			MEMBER_FUNCTION(operator_and));
-	}
+	const ys_runtime_operator_table_t YosenBoolean::s_runtime_operator_functions = make_runtime_operator_table({
+		{ RuntimeOperator::BoolOpEqu,			operator_equ },
+		{ RuntimeOperator::BoolOpNotEqu,		operator_notequ },
+		{ RuntimeOperator::BoolOpGreaterThan,	operator_greater },
+		{ RuntimeOperator::BoolOpLessThan,		operator_less },
+		{ RuntimeOperator::BoolOpOr,			operator_or },
+		{ RuntimeOperator::BoolOpAnd,			operator_and },
+	});
 
 	YosenObject* YosenBoolean::operator_equ(YosenObject* lhs, YosenObject* rhs)
 	{
-		if (strcmp(rhs->runtime_name(), "Boolean") != 0)
+		if (!rhs->is<YosenBoolean>())
 		{
 			auto ex_reason = std::string("cannot call a boolean operator on types Boolean and ") + rhs->runtime_name();
 			YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
 			return nullptr;
 		}
 
-		auto left_val = static_cast<YosenBoolean*>(lhs)->value;
-		auto right_val = static_cast<YosenBoolean*>(rhs)->value;;
+		auto left_val = lhs->as<YosenBoolean>()->value;
+		auto right_val = rhs->as<YosenBoolean>()->value;;
 
-		return allocate_object<YosenBoolean>(left_val == right_val);
+		return get_boolean_object(left_val == right_val);
 	}
 
 	YosenObject* YosenBoolean::operator_notequ(YosenObject* lhs, YosenObject* rhs)
 	{
-		if (strcmp(rhs->runtime_name(), "Boolean") != 0)
+		if (!rhs->is<YosenBoolean>())
 		{
 			auto ex_reason = std::string("cannot call a boolean operator on types Boolean and ") + rhs->runtime_name();
 			YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
 			return nullptr;
 		}
 
-		auto left_val = static_cast<YosenBoolean*>(lhs)->value;
-		auto right_val = static_cast<YosenBoolean*>(rhs)->value;;
+		auto left_val = lhs->as<YosenBoolean>()->value;
+		auto right_val = rhs->as<YosenBoolean>()->value;;
 
-		return allocate_object<YosenBoolean>(left_val != right_val);
+		return get_boolean_object(left_val != right_val);
 	}
 
 	YosenObject* YosenBoolean::operator_greater(YosenObject* lhs, YosenObject* rhs)
 	{
-		if (strcmp(rhs->runtime_name(), "Boolean") != 0)
+		if (!rhs->is<YosenBoolean>())
 		{
 			auto ex_reason = std::string("cannot call a boolean operator on types Boolean and ") + rhs->runtime_name();
 			YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
 			return nullptr;
 		}
 
-		auto left_val = static_cast<YosenBoolean*>(lhs)->value;
-		auto right_val = static_cast<YosenBoolean*>(rhs)->value;;
+		auto left_val = lhs->as<YosenBoolean>()->value;
+		auto right_val = rhs->as<YosenBoolean>()->value;;
 
-		return allocate_object<YosenBoolean>(left_val > right_val);
+		return get_boolean_object(left_val > right_val);
 	}
 
 	YosenObject* YosenBoolean::operator_less(YosenObject* lhs, YosenObject* rhs)
 	{
-		if (strcmp(rhs->runtime_name(), "Boolean") != 0)
+		if (!rhs->is<YosenBoolean>())
 		{
 			auto ex_reason = std::string("cannot call a boolean operator on types Boolean and ") + rhs->runtime_name();
 			YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
 			return nullptr;
 		}
 
-		auto left_val = static_cast<YosenBoolean*>(lhs)->value;
-		auto right_val = static_cast<YosenBoolean*>(rhs)->value;;
+		auto left_val = lhs->as<YosenBoolean>()->value;
+		auto right_val = rhs->as<YosenBoolean>()->value;;
 
-		return allocate_object<YosenBoolean>(left_val < right_val);
+		return get_boolean_object(left_val < right_val);
 	}
 
 	YosenObject* YosenBoolean::operator_or(YosenObject* lhs, YosenObject* rhs)
 	{
-		if (strcmp(rhs->runtime_name(), "Boolean") != 0)
+		if (!rhs->is<YosenBoolean>())
 		{
 			auto ex_reason = std::string("cannot call a boolean operator on types Boolean and ") + rhs->runtime_name();
 			YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
 			return nullptr;
 		}
 
-		auto left_val = static_cast<YosenBoolean*>(lhs)->value;
-		auto right_val = static_cast<YosenBoolean*>(rhs)->value;;
+		auto left_val = lhs->as<YosenBoolean>()->value;
+		auto right_val = rhs->as<YosenBoolean>()->value;;
 
-		return allocate_object<YosenBoolean>(left_val || right_val);
+		return get_boolean_object(left_val || right_val);
 	}
 
 	YosenObject* YosenBoolean::operator_and(YosenObject* lhs, YosenObject* rhs)
 	{
-		if (strcmp(rhs->runtime_name(), "Boolean") != 0)
+		if (!rhs->is<YosenBoolean>())
 		{
 			auto ex_reason = std::string("cannot call a boolean operator on types Boolean and ") + rhs->runtime_name();
 			YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
 			return nullptr;
 		}
 
-		auto left_val = static_cast<YosenBoolean*>(lhs)->value;
-		auto right_val = static_cast<YosenBoolean*>(rhs)->value;;
+		auto left_val = lhs->as<YosenBoolean>()->value;
+		auto right_val = rhs->as<YosenBoolean>()->value;;
 
-		return allocate_object<YosenBoolean>(left_val && right_val);
+		return get_boolean_object(left_val && right_val);
 	}
 }
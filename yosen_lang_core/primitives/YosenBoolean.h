@@ -6,6 +6,8 @@ namespace yosen
 	class YosenBoolean : public YosenObject
 	{
 	public:
+		static constexpr ObjectType object_type = ObjectType::Boolean;
+
 		YOSENAPI YosenBoolean();
 		YOSENAPI YosenBoolean(bool val);
 
@@ -16,13 +18,19 @@ namespace yosen
 		bool value = false;
 
 	private:
-		void register_runtime_operator_functions();
+		static const ys_runtime_operator_table_t s_runtime_operator_functions;
 
-		YosenObject* operator_equ(YosenObject* lhs, YosenObject* rhs);
-		YosenObject* operator_notequ(YosenObject* lhs, YosenObject* rhs);
-		YosenObject* operator_greater(YosenObject* lhs, YosenObject* rhs);
-		YosenObject* operator_less(YosenObject* lhs, YosenObject* rhs);
-		YosenObject* operator_or(YosenObject* lhs, YosenObject* rhs);
-		YosenObject* operator_and(YosenObject* lhs, YosenObject* rhs);
+		static YosenObject* operator_equ(YosenObject* lhs, YosenObject* rhs);
+		static YosenObject* operator_notequ(YosenObject* lhs, YosenObject* rhs);
+		static YosenObject* operator_greater(YosenObject* lhs, YosenObject* rhs);
+		static YosenObject* operator_less(YosenObject* lhs, YosenObject* rhs);
+		static YosenObject* operator_or(YosenObject* lhs, YosenObject* rhs);
+		static YosenObject* operator_and(YosenObject* lhs, YosenObject* rhs);
 	};
+
+	// Returns the shared immortal boolean object for the given value
+	inline YosenObject* get_boolean_object(bool value)
+	{
+		return value ? YosenObject_True : YosenObject_False;
+	}
 }
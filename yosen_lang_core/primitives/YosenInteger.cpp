@@ -3,14 +3,14 @@
 
 namespace yosen
 {
-	YosenInteger::YosenInteger()
+	YosenInteger::YosenInteger() : YosenObject(object_type)
 	{
-		register_runtime_operator_functions();
+		m_runtime_operator_table = &s_runtime_operator_functions;
 	}
 
-	YosenInteger::YosenInteger(int64_t val) : value(val)
+	YosenInteger::YosenInteger(int64_t val) : YosenObject(object_type), value(val)
 	{
-		register_runtime_operator_functions();
+		m_runtime_operator_table = &s_runtime_operator_functions;
 	}
 
 	YosenObject* YosenInteger::clone()
@@ -29,116 +29,115 @@ namespace yosen
 		return "Integer";
 	}
 
-	void YosenInteger::register_runtime_operator_functions()
-	{
-		add_runtime_operator_function(RuntimeOperator::BinOpAdd,			MEMBER_FUNCTION(operator_add));
-		add_runtime_operator_function(RuntimeOperator::BinOpSub,			MEMBER_FUNCTION(operator_sub));
-		add_runtime_operator_function(RuntimeOperator::BinOpMul,			MEMBER_FUNCTION(operator_mul));
-		add_runtime_operator_function(RuntimeOperator::BinOpDiv,			MEMBER_FUNCTION(operator_div));
-		add_runtime_operator_function(RuntimeOperator::BinOpMod,			MEMBER_FUNCTION(operator_mod));
-		add_runtime_operator_function(RuntimeOperator::BoolOpEqu,			MEMBER_FUNCTION(operator_equ));
-		add_runtime_operator_function(RuntimeOperator::BoolOpNotEqu,		MEMBER_FUNCTION(operator_notequ));
-		add_runtime_operator_function(RuntimeOperator::BoolOpGreaterThan,	MEMBER_FUNCTION(operator_greater));
-		add_runtime_operator_function(RuntimeOperator::BoolOpLessThan,		MEMBER_FUNCTION(operator_less));
-	}
+	const ys_runtime_operator_table_t YosenInteger::s_runtime_operator_functions = make_runtime_operator_table({
+		{ RuntimeOperator::BinOpAdd,			operator_add },
+		{ RuntimeOperator::BinOpSub,			operator_sub },
+		{ RuntimeOperator::BinOpMul,			operator_mul },
+		{ RuntimeOperator::BinOpDiv,			operator_div },
+		{ RuntimeOperator::BinOpMod,			operator_mod },
+		{ RuntimeOperator::BoolOpEqu,			operator_equ },
+		{ RuntimeOperator::BoolOpNotEqu,		operator_notequ },
+		{ RuntimeOperator::BoolOpGreaterThan,	operator_greater },
+		{ RuntimeOperator::BoolOpLessThan,		operator_less },
+	});
 
 	YosenObject* YosenInteger::operator_add(YosenObject* lhs, YosenObject* rhs)
 	{
-		auto left_val = static_cast<YosenInteger*>(lhs)->value;
-		auto right_val = static_cast<YosenInteger*>(rhs)->value;
+		auto left_val = lhs->as<YosenInteger>()->value;
+		auto right_val = rhs->as<YosenInteger>()->value;
 
 		return allocate_object<YosenInteger>(left_val + right_val);
 	}
 
 	YosenObject* YosenInteger::operator_sub(YosenObject* lhs, YosenObject* rhs)
 	{
-		auto left_val = static_cast<YosenInteger*>(lhs)->value;
-		auto right_val = static_cast<YosenInteger*>(rhs)->value;
+		auto left_val = lhs->as<YosenInteger>()->value;
+		auto right_val = rhs->as<YosenInteger>()->value;
 
 		return allocate_object<YosenInteger>(left_val - right_val);
 	}
 
 	YosenObject* YosenInteger::operator_mul(YosenObject* lhs, YosenObject* rhs)
 	{
-		auto left_val = static_cast<YosenInteger*>(lhs)->value;
-		auto right_val = static_cast<YosenInteger*>(rhs)->value;
+		auto left_val = lhs->as<YosenInteger>()->value;
+		auto right_val = rhs->as<YosenInteger>()->value;
 
 		return allocate_object<YosenInteger>(left_val * right_val);
 	}
 
 	YosenObject* YosenInteger::operator_div(YosenObject* lhs, YosenObject* rhs)
 	{
-		auto left_val = static_cast<YosenInteger*>(lhs)->value;
-		auto right_val = static_cast<YosenInteger*>(rhs)->value;
+		auto left_val = lhs->as<YosenInteger>()->value;
+		auto right_val = rhs->as<YosenInteger>()->value;
 
 		return allocate_object<YosenInteger>(left_val / right_val);
 	}
 	
 	YosenObject* YosenInteger::operator_mod(YosenObject* lhs, YosenObject* rhs)
 	{
-		auto left_val = static_cast<YosenInteger*>(lhs)->value;
-		auto right_val = static_cast<YosenInteger*>(rhs)->value;
+		auto left_val = lhs->as<YosenInteger>()->value;
+		auto right_val = rhs->as<YosenInteger>()->value;
 
 		return allocate_object<YosenInteger>(left_val % right_val);
 	}
 
 	YosenObject* YosenInteger::operator_equ(YosenObject* lhs, YosenObject* rhs)
 	{
-		if (strcmp(rhs->runtime_name(), "Integer") != 0)
+		if (!rhs->is<YosenInteger>())
 		{
 			auto ex_reason = std::string("cannot compare objects of type ") + rhs->runtime_name() + " and Integer";
 			YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
 			return nullptr;
 		}
 
-		auto left_val = static_cast<YosenInteger*>(lhs)->value;
-		auto right_val = static_cast<YosenInteger*>(rhs)->value;
+		auto left_val = lhs->as<YosenInteger>()->value;
+		auto right_val = rhs->as<YosenInteger>()->value;
 
-		return allocate_object<YosenBoolean>(left_val == right_val);
+		return get_boolean_object(left_val == right_val);
 	}
 	
 	YosenObject* YosenInteger::operator_notequ(YosenObject* lhs, YosenObject* rhs)
 	{
-		if (strcmp(rhs->runtime_name(), "Integer") != 0)
+		if (!rhs->is<YosenInteger>())
 		{
 			auto ex_reason = std::string("cannot compare objects of type ") + rhs->runtime_name() + " and Integer";
 			YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
 			return nullptr;
 		}
 
-		auto left_val = static_cast<YosenInteger*>(lhs)->value;
-		auto right_val = static_cast<YosenInteger*>(rhs)->value;
+		auto left_val = lhs->as<YosenInteger>()->value;
+		auto right_val = rhs->as<YosenInteger>()->value;
 
-		return allocate_object<YosenBoolean>(left_val != right_val);
+		return get_boolean_object(left_val != right_val);
 	}
 	
 	YosenObject* YosenInteger::operator_greater(YosenObject* lhs, YosenObject* rhs)
 	{
-		if (strcmp(rhs->runtime_name(), "Integer") != 0)
+		if (!rhs->is<YosenInteger>())
 		{
 			auto ex_reason = std::string("cannot compare objects of type ") + rhs->runtime_name() + " and Integer";
 			YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
 			return nullptr;
 		}
 
-		auto left_val = static_cast<YosenInteger*>(lhs)->value;
-		auto right_val = static_cast<YosenInteger*>(rhs)->value;
+		auto left_val = lhs->as<YosenInteger>()->value;
+		auto right_val = rhs->as<YosenInteger>()->value;
 
-		return allocate_object<YosenBoolean>(left_val > right_val);
+		return get_boolean_object(left_val > right_val);
 	}
 	
 	YosenObject* YosenInteger::operator_less(YosenObject* lhs, YosenObject* rhs)
 	{
-		if (strcmp(rhs->runtime_name(), "Integer") != 0)
+		if (!rhs->is<YosenInteger>())
 		{
 			auto ex_reason = std::string("cannot compare objects of type ") + rhs->runtime_name() + " and Integer";
 			YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
 			return nullptr;
 		}
 
-		auto left_val = static_cast<YosenInteger*>(lhs)->value;
-		auto right_val = static_cast<YosenInteger*>(rhs)->value;
+		auto left_val = lhs->as<YosenInteger>()->value;
+		auto right_val = rhs->as<YosenInteger>()->value;
 
-		return allocate_object<YosenBoolean>(left_val < right_val);
+		return get_boolean_object(left_val < right_val);
 	}
 }
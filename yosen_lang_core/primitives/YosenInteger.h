@@ -6,6 +6,8 @@ namespace yosen
 	class YosenInteger : public YosenObject
 	{
 	public:
+		static constexpr ObjectType object_type = ObjectType::Integer;
+
 		YOSENAPI YosenInteger();
 		YOSENAPI YosenInteger(int64_t val);
 
@@ -16,16 +18,16 @@ namespace yosen
 		int64_t value = 0;
 
 	private:
-		void register_runtime_operator_functions();
+		static const ys_runtime_operator_table_t s_runtime_operator_functions;
 
-		YosenObject* operator_add(YosenObject* lhs, YosenObject* rhs);
-		YosenObject* operator_sub(YosenObject* lhs, YosenObject* rhs);
-		YosenObject* operator_mul(YosenObject* lhs, YosenObject* rhs);
-		YosenObject* operator_div(YosenObject* lhs, YosenObject* rhs);
-		YosenObject* operator_mod(YosenObject* lhs, YosenObject* rhs);
-		YosenObject* operator_equ(YosenObject* lhs, YosenObject* rhs);
-		YosenObject* operator_notequ(YosenObject* lhs, YosenObject* rhs);
-		YosenObject* operator_greater(YosenObject* lhs, YosenObject* rhs);
-		YosenObject* operator_less(YosenObject* lhs, YosenObject* rhs);
+		static YosenObject* operator_add(YosenObject* lhs, YosenObject* rhs);
+		static YosenObject* operator_sub(YosenObject* lhs, YosenObject* rhs);
+		static YosenObject* operator_mul(YosenObject* lhs, YosenObject* rhs);
+		static YosenObject* operator_div(YosenObject* lhs, YosenObject* rhs);
+		static YosenObject* operator_mod(YosenObject* lhs, YosenObject* rhs);
+		static YosenObject* operator_equ(YosenObject* lhs, YosenObject* rhs);
+		static YosenObject* operator_notequ(YosenObject* lhs, YosenObject* rhs);
+		static YosenObject* operator_greater(YosenObject* lhs, YosenObject* rhs);
+		static YosenObject* operator_less(YosenObject* lhs, YosenObject* rhs);
 	};
 }
@@ -1,18 +1,19 @@
 #include "YosenList.h"
 #include <YosenEnvironment.h>
 #include <algorithm>
+#include <optional>
 
 namespace yosen
 {
-	YosenList::YosenList()
+	YosenList::YosenList() : YosenObject(object_type)
 	{
-		register_member_native_functions();
+		m_member_native_table = &s_member_native_functions;
 	}
 
 	YosenList::YosenList(const std::vector<YosenObject*>& items)
-		: items(items)
+		: YosenObject(object_type), items(items)
 	{
-		register_member_native_functions();
+		m_member_native_table = &s_member_native_functions;
 	}
 
 	YosenList::~YosenList()
@@ -50,28 +51,31 @@ namespace yosen
 		return "List";
 	}
 
-	void YosenList::register_member_native_functions()
-	{
-		add_member_native_function("get",		MEMBER_FUNCTION(get));
-		add_member_native_function("add",		MEMBER_FUNCTION(add));
-		add_member_native_function("remove",	MEMBER_FUNCTION(remove));
-		add_member_native_function("clear",		MEMBER_FUNCTION(clear));
-		add_member_native_function("length",	MEMBER_FUNCTION(length));
-		add_member_native_function("contains",	MEMBER_FUNCTION(contains));
-		add_member_native_function("find",		MEMBER_FUNCTION(find));
-		add_member_native_function("is_empty",	MEMBER_FUNCTION(is_empty));
-		add_member_native_function("slice",		MEMBER_FUNCTION(slice));
-		add_member_native_function("first",		MEMBER_FUNCTION(first));
-		add_member_native_function("last",		MEMBER_FUNCTION(last));
-		add_member_native_function("pop_back",	MEMBER_FUNCTION(pop_back));
-	}
+	const ys_member_native_table_t YosenList::s_member_native_functions = {
+		{ "get",		get },
+		{ "add",		add },
+		{ "remove",	remove },
+		{ "clear",		clear },
+		{ "length",	length },
+		{ "contains",	contains },
+		{ "find",		find },
+		{ "is_empty",	is_empty },
+		{ "slice",		slice },
+		{ "first",		first },
+		{ "last",		last },
+		{ "pop_back",	pop_back },
+		{ "par_map",	par_map },
+		{ "par_filter",	par_filter },
+		{ "par_reduce",	par_reduce },
+	};
 	
-	YosenObject* YosenList::get(YosenObject* self, YosenObject* args)
+	YosenObject* YosenList::get(YosenObject* self, YosenArgs args)
 	{
 		int64_t index;
-		arg_parse(args, "i", &index);
+		if (!arg_parse(args, index))
+			return nullptr;
 
-		auto this_obj = static_cast<YosenList*>(self);
+		auto this_obj = self->as<YosenList>();
 
 		if (index < 0 || index >= (int64_t)this_obj->items.size())
 		{
@@ -83,23 +87,25 @@ namespace yosen
 		return this_obj->items[index]->clone();
 	}
 	
-	YosenObject* YosenList::add(YosenObject* self, YosenObject* args)
+	YosenObject* YosenList::add(YosenObject* self, YosenArgs args)
 	{
 		YosenObject* obj;
-		arg_parse(args, "o", &obj);
+		if (!arg_parse(args, obj))
+			return nullptr;
 
-		auto this_obj = static_cast<YosenList*>(self);
+		auto this_obj = self->as<YosenList>();
 		this_obj->items.push_back(obj->clone());
 
-		return YosenObject_Null->clone();
+		return YosenObject_Null;
 	}
 	
-	YosenObject* YosenList::remove(YosenObject* self, YosenObject* args)
+	YosenObject* YosenList::remove(YosenObject* self, YosenArgs args)
 	{
 		int64_t index;
-		arg_parse(args, "i", &index);
+		if (!arg_parse(args, index))
+			return nullptr;
 
-		auto this_obj = static_cast<YosenList*>(self);
+		auto this_obj = self->as<YosenList>();
 
 		if (index < 0 || index >= (int64_t)this_obj->items.size())
 		{
@@ -109,54 +115,47 @@ namespace yosen
 		}
 
 		this_obj->items.erase(this_obj->items.begin() + index);
-		return YosenObject_Null->clone();
+		return YosenObject_Null;
 	}
 	
-	YosenObject* YosenList::clear(YosenObject* self, YosenObject* args)
+	YosenObject* YosenList::clear(YosenObject* self, YosenArgs args)
 	{
-		arg_parse(args, "");
-
-		auto this_obj = static_cast<YosenList*>(self);
+		auto this_obj = self->as<YosenList>();
 
 		for (auto& item : this_obj->items)
 			free_object(item);
 
 		this_obj->items.clear();
 
-		return YosenObject_Null->clone();
+		return YosenObject_Null;
 	}
 	
-	YosenObject* YosenList::length(YosenObject* self, YosenObject* args)
+	YosenObject* YosenList::length(YosenObject* self, YosenArgs args)
 	{
-		arg_parse(args, "");
-		auto this_obj = static_cast<YosenList*>(self);
+		auto this_obj = self->as<YosenList>();
 
 		return allocate_object<YosenInteger>((int64_t)this_obj->items.size());
 	}
 
-	YosenObject* YosenList::contains(YosenObject* self, YosenObject* args)
+	YosenObject* YosenList::contains(YosenObject* self, YosenArgs args)
 	{
 		YosenObject* target = nullptr;
-		arg_parse(args, "o", &target);
-
-		if (!target)
+		if (!arg_parse(args, target))
 			return nullptr;
 
-		auto this_obj = static_cast<YosenList*>(self);
+		auto this_obj = self->as<YosenList>();
 
 		bool result = std::find(this_obj->items.begin(), this_obj->items.end(), target) != this_obj->items.end();
-		return allocate_object<YosenBoolean>(result);
+		return get_boolean_object(result);
 	}
 
-	YosenObject* YosenList::find(YosenObject* self, YosenObject* args)
+	YosenObject* YosenList::find(YosenObject* self, YosenArgs args)
 	{
 		YosenObject* target = nullptr;
-		arg_parse(args, "o", &target);
-
-		if (!target)
+		if (!arg_parse(args, target))
 			return nullptr;
 
-		auto this_obj = static_cast<YosenList*>(self);
+		auto this_obj = self->as<YosenList>();
 
 		auto it = std::find(this_obj->items.begin(), this_obj->items.end(), target);
 		
@@ -167,23 +166,22 @@ namespace yosen
 		return allocate_object<YosenInteger>(result);
 	}
 
-	YosenObject* YosenList::is_empty(YosenObject* self, YosenObject* args)
+	YosenObject* YosenList::is_empty(YosenObject* self, YosenArgs args)
 	{
-		arg_parse(args, "");
-
-		auto this_obj = static_cast<YosenList*>(self);
+		auto this_obj = self->as<YosenList>();
 		bool result = this_obj->items.empty();
 
-		return allocate_object<YosenBoolean>(result);
+		return get_boolean_object(result);
 	}
 
-	YosenObject* YosenList::slice(YosenObject* self, YosenObject* args)
+	YosenObject* YosenList::slice(YosenObject* self, YosenArgs args)
 	{
 		int64_t start = 0;
 		int64_t end = 0;
-		arg_parse(args, "ii", &start, &end);
+		if (!arg_parse(args, start, end))
+			return nullptr;
 
-		auto this_obj = static_cast<YosenList*>(self);
+		auto this_obj = self->as<YosenList>();
 
 		if (start < 0 || start >= (int64_t)this_obj->items.size())
 		{
@@ -206,10 +204,9 @@ namespace yosen
 		return allocate_object<YosenList>(resulting_list);
 	}
 
-	YosenObject* YosenList::first(YosenObject* self, YosenObject* args)
+	YosenObject* YosenList::first(YosenObject* self, YosenArgs args)
 	{
-		arg_parse(args, "");
-		auto this_obj = static_cast<YosenList*>(self);
+		auto this_obj = self->as<YosenList>();
 
 		if (!this_obj->items.size())
 		{
@@ -221,10 +218,9 @@ namespace yosen
 		return this_obj->items.at(0)->clone();
 	}
 
-	YosenObject* YosenList::last(YosenObject* self, YosenObject* args)
+	YosenObject* YosenList::last(YosenObject* self, YosenArgs args)
 	{
-		arg_parse(args, "");
-		auto this_obj = static_cast<YosenList*>(self);
+		auto this_obj = self->as<YosenList>();
 
 		if (!this_obj->items.size())
 		{
@@ -236,12 +232,261 @@ namespace yosen
 		return this_obj->items.back()->clone();
 	}
 
-	YosenObject* YosenList::pop_back(YosenObject* self, YosenObject* args)
+	YosenObject* YosenList::pop_back(YosenObject* self, YosenArgs args)
 	{
-		arg_parse(args, "");
-		auto this_obj = static_cast<YosenList*>(self);
+		auto this_obj = self->as<YosenList>();
 		this_obj->items.pop_back();
 
-		return YosenObject_Null->clone();
+		return YosenObject_Null;
+	}
+
+	// Function called by the parallel list operations. Native functions are
+	// called directly, runtime functions go through an execution context.
+	struct ParallelListCallback
+	{
+		std::string name;
+		ys_static_native_fn_t native_fn = nullptr;
+
+		inline YosenObject* call(YosenExecutionContext* context, YosenArgs args) const
+		{
+			YosenObject* result = nullptr;
+
+			if (native_fn)
+				result = native_fn(args);
+			else if (context)
+			{
+				result = context->call_function(name, args);
+
+				// The context catches the exceptions of the runtime function
+				if (!result)
+					YosenEnvironment::get().throw_exception(*context->get_last_exception());
+			}
+
+			return result ? result : YosenObject_Null;
+		}
+	};
+
+	static bool get_parallel_list_callback(const std::string& name, ParallelListCallback& callback)
+	{
+		auto& env = YosenEnvironment::get();
+		callback.name = name;
+
+		if (env.is_static_native_function(name))
+		{
+			callback.native_fn = env.get_static_native_function(name);
+			return true;
+		}
+
+		if (env.is_static_runtime_function(name))
+			return true;
+
+		auto ex_reason = "Static function \"" + name + "\" not found";
+		env.throw_exception(RuntimeException(ex_reason));
+		return false;
+	}
+
+	// Splits the items into contiguous chunks that are processed on the task pool,
+	// chunk_fn(chunk_idx, begin, end, context, exception) is called once for every chunk
+	// and should stop once the exception is set. Returns false if the callback threw,
+	// the exception of the first failed chunk is then thrown again on the calling thread.
+	template <typename ChunkFn>
+	static bool run_parallel_list_chunks(size_t item_count, const ParallelListCallback& callback, ChunkFn chunk_fn, size_t* chunk_count_out = nullptr)
+	{
+		auto& env = YosenEnvironment::get();
+		auto& pool = YosenTaskPool::get();
+
+		// A few chunks per worker keep the workers busy when chunks take uneven time
+		size_t chunk_count = std::min(item_count, pool.worker_count() * 4);
+		if (chunk_count_out)
+			*chunk_count_out = 0;
+
+		if (!chunk_count)
+			return true;
+
+		size_t chunk_size = (item_count + chunk_count - 1) / chunk_count;
+		chunk_count = (item_count + chunk_size - 1) / chunk_size;
+
+		YosenTaskLatch latch(chunk_count);
+
+		// Each chunk only records the first exception thrown while processing it
+		std::vector<std::optional<YosenException>> chunk_exceptions(chunk_count);
+
+		for (size_t i = 0; i < chunk_count; ++i)
+		{
+			size_t begin = i * chunk_size;
+			size_t end = std::min(begin + chunk_size, item_count);
+
+			pool.submit([&env, &callback, &chunk_fn, &latch, &chunk_exceptions, i, begin, end]() {
+				YosenEnvironmentScope env_scope(&env);
+
+				auto& chunk_exception = chunk_exceptions[i];
+
+				exception_handler_t exception_handler = [&chunk_exception](const YosenException& ex) {
+					if (!chunk_exception)
+						chunk_exception = ex;
+				};
+
+				YosenExceptionHandlerScope exception_handler_scope(&exception_handler);
+
+				// Native functions run without an interpreter
+				std::unique_ptr<YosenExecutionContext> context;
+				if (!callback.native_fn)
+				{
+					context = env.create_execution_context();
+
+					if (!context)
+						env.throw_exception(RuntimeException("No interpreter is available to run \"" + callback.name + "\""));
+				}
+
+				if (!chunk_exception)
+					chunk_fn(i, begin, end, context.get(), chunk_exception);
+
+				latch.count_down();
+			});
+		}
+
+		pool.wait(latch);
+
+		for (auto& chunk_exception : chunk_exceptions)
+		{
+			if (chunk_exception)
+			{
+				env.throw_exception(*chunk_exception);
+				return false;
+			}
+		}
+
+		if (chunk_count_out)
+			*chunk_count_out = chunk_count;
+
+		return true;
+	}
+
+	YosenObject* YosenList::par_map(YosenObject* self, YosenArgs args)
+	{
+		std::string fn_name;
+		if (!arg_parse(args, fn_name))
+			return nullptr;
+
+		ParallelListCallback callback;
+		if (!get_parallel_list_callback(fn_name, callback))
+			return nullptr;
+
+		auto& items = self->as<YosenList>()->items;
+
+		// Every chunk writes only to its own range of results
+		std::vector<YosenObject*> results(items.size());
+
+		bool succeeded = run_parallel_list_chunks(items.size(), callback, [&](size_t, size_t begin, size_t end, YosenExecutionContext* context, const std::optional<YosenException>& exception) {
+			for (size_t i = begin; i < end && !exception; ++i)
+				results[i] = callback.call(context, YosenArgs(&items[i], 1));
+		});
+
+		if (!succeeded)
+		{
+			for (auto& result : results)
+				if (result) free_object(result);
+
+			return nullptr;
+		}
+
+		return allocate_object<YosenList>(results);
+	}
+
+	YosenObject* YosenList::par_filter(YosenObject* self, YosenArgs args)
+	{
+		std::string fn_name;
+		if (!arg_parse(args, fn_name))
+			return nullptr;
+
+		ParallelListCallback callback;
+		if (!get_parallel_list_callback(fn_name, callback))
+			return nullptr;
+
+		auto& items = self->as<YosenList>()->items;
+
+		// Bytes instead of std::vector<bool> so that chunks don't share words
+		std::vector<uint8_t> keep_item(items.size());
+
+		bool succeeded = run_parallel_list_chunks(items.size(), callback, [&](size_t, size_t begin, size_t end, YosenExecutionContext* context, const std::optional<YosenException>& exception) {
+			for (size_t i = begin; i < end && !exception; ++i)
+			{
+				auto result = callback.call(context, YosenArgs(&items[i], 1));
+
+				keep_item[i] = result->is<YosenBoolean>() && result->as<YosenBoolean>()->value;
+				free_object(result);
+			}
+		});
+
+		if (!succeeded)
+			return nullptr;
+
+		std::vector<YosenObject*> resulting_list;
+		for (size_t i = 0; i < items.size(); ++i)
+			if (keep_item[i])
+				resulting_list.push_back(items[i]->clone());
+
+		return allocate_object<YosenList>(resulting_list);
+	}
+
+	YosenObject* YosenList::par_reduce(YosenObject* self, YosenArgs args)
+	{
+		std::string fn_name;
+		YosenObject* init = nullptr;
+		if (!arg_parse(args, fn_name, init))
+			return nullptr;
+
+		ParallelListCallback callback;
+		if (!get_parallel_list_callback(fn_name, callback))
+			return nullptr;
+
+		auto& items = self->as<YosenList>()->items;
+
+		// Each chunk is reduced separately starting with its first item,
+		// so the function has to be associative for the result to be exact.
+		std::vector<YosenObject*> chunk_results(items.size());
+
+		auto chunk_fn = [&](size_t chunk_idx, size_t begin, size_t end, YosenExecutionContext* context, const std::optional<YosenException>& exception) {
+			auto accumulator = items[begin]->clone();
+
+			for (size_t i = begin + 1; i < end && !exception; ++i)
+			{
+				YosenObject* fn_args[] = { accumulator, items[i] };
+				auto result = callback.call(context, YosenArgs(fn_args, 2));
+
+				free_object(accumulator);
+				accumulator = result;
+			}
+
+			chunk_results[chunk_idx] = accumulator;
+		};
+
+		size_t chunk_count = 0;
+		if (!run_parallel_list_chunks(items.size(), callback, chunk_fn, &chunk_count))
+		{
+			for (auto& chunk_result : chunk_results)
+				if (chunk_result) free_object(chunk_result);
+
+			return nullptr;
+		}
+
+		// Combine the chunk results in order on the calling thread
+		std::unique_ptr<YosenExecutionContext> context;
+		if (!callback.native_fn)
+			context = YosenEnvironment::get().create_execution_context();
+
+		auto accumulator = init->clone();
+
+		for (size_t i = 0; i < chunk_count; ++i)
+		{
+			YosenObject* fn_args[] = { accumulator, chunk_results[i] };
+			auto result = callback.call(context.get(), YosenArgs(fn_args, 2));
+
+			free_object(accumulator);
+			free_object(chunk_results[i]);
+			accumulator = result;
+		}
+
+		return accumulator;
 	}
 }
@@ -6,6 +6,8 @@ namespace yosen
 	class YosenList : public YosenObject
 	{
 	public:
+		static constexpr ObjectType object_type = ObjectType::List;
+
 		YOSENAPI YosenList();
 		YOSENAPI YosenList(const std::vector<YosenObject*>& items);
 		YOSENAPI ~YosenList();
@@ -17,19 +19,22 @@ namespace yosen
 		std::vector<YosenObject*> items;
 
 	private:
-		void register_member_native_functions();
+		static const ys_member_native_table_t s_member_native_functions;
 
-		YosenObject* get(YosenObject* self, YosenObject* args);
-		YosenObject* add(YosenObject* self, YosenObject* args);
-		YosenObject* remove(YosenObject* self, YosenObject* args);
-		YosenObject* clear(YosenObject* self, YosenObject* args);
-		YosenObject* length(YosenObject* self, YosenObject* args);
-		YosenObject* contains(YosenObject* self, YosenObject* args);
-		YosenObject* find(YosenObject* self, YosenObject* args);
-		YosenObject* is_empty(YosenObject* self, YosenObject* args);
-		YosenObject* slice(YosenObject* self, YosenObject* args);
-		YosenObject* first(YosenObject* self, YosenObject* args);
-		YosenObject* last(YosenObject* self, YosenObject* args);
-		YosenObject* pop_back(YosenObject* self, YosenObject* args);
+		static YosenObject* get(YosenObject* self, YosenArgs args);
+		static YosenObject* add(YosenObject* self, YosenArgs args);
+		static YosenObject* remove(YosenObject* self, YosenArgs args);
+		static YosenObject* clear(YosenObject* self, YosenArgs args);
+		static YosenObject* length(YosenObject* self, YosenArgs args);
+		static YosenObject* contains(YosenObject* self, YosenArgs args);
+		static YosenObject* find(YosenObject* self, YosenArgs args);
+		static YosenObject* is_empty(YosenObject* self, YosenArgs args);
+		static YosenObject* slice(YosenObject* self, YosenArgs args);
+		static YosenObject* first(YosenObject* self, YosenArgs args);
+		static YosenObject* last(YosenObject* self, YosenArgs args);
+		static YosenObject* pop_back(YosenObject* self, YosenArgs args);
+		static YosenObject* par_map(YosenObject* self, YosenArgs args);
+		static YosenObject* par_filter(YosenObject* self, YosenArgs args);
+		static YosenObject* par_reduce(YosenObject* self, YosenArgs args);
 	};
 }
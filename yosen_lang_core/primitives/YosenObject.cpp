@@ -1,7 +1,6 @@
 #include "YosenObject.h"
 #include <sstream>
 #include <algorithm>
-#include <stdarg.h>
 
 // Primitive Types
 #include <primitives/primitives.h>
@@ -12,7 +11,8 @@
 namespace yosen
 {
 	YosenObject* YosenObject_Null = nullptr;
-	static uint64_t s_total_allocated_objects = 0;
+	YosenObject* YosenObject_True = nullptr;
+	YosenObject* YosenObject_False = nullptr;
 
 	static std::string runtime_op_to_string(RuntimeOperator op)
 	{
@@ -33,17 +33,13 @@ namespace yosen
 		}
 	}
 
-	YosenObject::YosenObject()
+	YosenObject::YosenObject() : YosenObject(ObjectType::Object)
 	{
-		const void* this_address = static_cast<const void*>(this);
-		std::stringstream ss;
-		ss << std::hex << this_address;
-
-		m_string_repr = std::string("<YosenObject at 0x") + ss.str() + ">";
+	}
 
-		add_member_native_function("ref", [this](YosenObject* self, YosenObject* args) -> YosenObject* {
-			return allocate_object<YosenReference>(self);
-		});
+	YosenObject::YosenObject(ObjectType type) : m_type(type)
+	{
+		m_member_native_table = &s_member_native_functions;
 	}
 
 	YosenObject::~YosenObject()
@@ -54,14 +50,16 @@ namespace yosen
 
 	YosenObject* YosenObject::clone()
 	{
-		YosenObject* new_obj = allocate_object<YosenObject>();
-		if (this->m_string_repr == "null")
-			new_obj->m_string_repr = "null";
+		// Immortal objects are shared instead of copied
+		if (m_immortal)
+			return this;
 
+		YosenObject* new_obj = allocate_object<YosenObject>();
 		new_obj->m_overriden_runtime_name = this->m_overriden_runtime_name;
+		new_obj->m_member_native_table = this->m_member_native_table;
+		new_obj->m_runtime_operator_table = this->m_runtime_operator_table;
 		new_obj->m_member_native_functions = this->m_member_native_functions;
 		new_obj->m_member_runtime_functions = this->m_member_runtime_functions;
-		new_obj->m_runtime_operator_functions = this->m_runtime_operator_functions;
 
 		for (auto& [name, var_obj] : m_member_variables)
 			new_obj->add_member_variable(name, var_obj->clone());
@@ -71,7 +69,7 @@ namespace yosen
 
 	std::string YosenObject::to_string()
 	{
-		return m_string_repr;
+		return instance_info();
 	}
 
 	const char* YosenObject::runtime_name() const
@@ -84,7 +82,14 @@ namespace yosen
 
 	std::string YosenObject::instance_info() const
 	{
-		return m_string_repr;
+		if (!m_string_repr.empty())
+			return m_string_repr;
+
+		// The address representation is only built when requested
+		std::stringstream ss;
+		ss << std::hex << static_cast<const void*>(this);
+
+		return std::string("<YosenObject at 0x") + ss.str() + ">";
 	}
 
 	void YosenObject::add_member_native_function(const std::string& name, ys_member_native_fn_t fn)
@@ -94,21 +99,48 @@ namespace yosen
 
 	bool YosenObject::has_member_native_function(const std::string& name)
 	{
-		return m_member_native_functions.find(name) != m_member_native_functions.end();
+		return find_member_native_function(name) != nullptr;
 	}
 
-	YosenObject* YosenObject::call_member_native_function(const std::string& name, YosenObject* args)
+	YosenObject* YosenObject::call_member_native_function(const std::string& name, YosenArgs args)
 	{
-		if (!has_member_native_function(name))
+		auto fn = find_member_native_function(name);
+		if (!fn)
 		{
 			printf("No member function '%s' found for object of type %s\n", name.c_str(), this->runtime_name());
-			return YosenObject_Null->clone();
+			return YosenObject_Null;
 		}
 
-		auto fn = m_member_native_functions[name];
 		return fn(this, args);
 	}
 
+	ys_member_native_fn_t YosenObject::find_member_native_function(const std::string& name)
+	{
+		if (!m_member_native_functions.empty())
+		{
+			auto it = m_member_native_functions.find(name);
+			if (it != m_member_native_functions.end())
+				return it->second;
+		}
+
+		if (m_member_native_table)
+		{
+			auto it = m_member_native_table->find(name);
+			if (it != m_member_native_table->end())
+				return it->second;
+		}
+
+		// Functions available on every object
+		if (m_member_native_table != &s_member_native_functions)
+		{
+			auto it = s_member_native_functions.find(name);
+			if (it != s_member_native_functions.end())
+				return it->second;
+		}
+
+		return nullptr;
+	}
+
 	void YosenObject::add_member_runtime_function(const std::string& name, ys_runtime_function_t fn)
 	{
 		m_member_runtime_functions[name] = fn;
@@ -144,126 +176,77 @@ namespace yosen
 		m_member_variables[name] = value;
 	}
 
-	void YosenObject::add_runtime_operator_function(RuntimeOperator op, ys_runtime_operator_fn_t fn)
-	{
-		if (fn) m_runtime_operator_functions[op] = fn;
-	}
-
 	YosenObject* YosenObject::call_runtime_operator_function(RuntimeOperator op, YosenObject* rhs)
 	{
-		auto& fn = m_runtime_operator_functions[op];
+		ys_runtime_operator_fn_t fn = nullptr;
+		if (m_runtime_operator_table)
+			fn = (*m_runtime_operator_table)[static_cast<size_t>(op)];
 
 		if (!fn)
 		{
 			auto ex_reason = "operator \"" + runtime_op_to_string(op) + "\" is not overloaded for type " + runtime_name();
 			YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
+			return nullptr;
 		}
 
 		return fn(this, rhs);
 	}
 
-	void __yosen_register_allocated_object(void* obj)
-	{
-		++s_total_allocated_objects;
-	}
+	const ys_member_native_table_t YosenObject::s_member_native_functions = {
+		{ "ref", ref },
+	};
 
-	uint64_t __yosen_get_total_allocated_objects()
+	YosenObject* YosenObject::ref(YosenObject* self, YosenArgs args)
 	{
-		return s_total_allocated_objects;
+		return allocate_object<YosenReference>(self);
 	}
 
 	void free_object(YosenObject* obj)
 	{
+		// Shared immortal objects are never deallocated
+		if (obj->is_immortal())
+			return;
+
+		__yosen_register_freed_object(obj);
 		delete obj;
-		--s_total_allocated_objects;
 
 #ifdef PROFILE_OBJECT_ALLOCATION
-		printf("YosenObject Freed,      total object count: %zi\n", s_total_allocated_objects);
+		printf("YosenObject Freed,      total object count: %zi\n", __yosen_get_total_allocated_objects());
 #endif // PROFILE_OBJECT_ALLOCATION
 	}
 	
-	bool arg_parse(YosenObject* obj, const char* fmt, ...)
+	static const char* object_type_to_string(ObjectType type)
 	{
-		if (strcmp(obj->runtime_name(), "Tuple") != 0)
-		{
-			throw "Argument not a tuple";
-		}
-
-		YosenTuple* args_tuple = dynamic_cast<YosenTuple*>(obj);
-		
-		size_t fmt_arg_count = strlen(fmt);
-		if (fmt_arg_count > args_tuple->items.size())
+		switch (type)
 		{
-			auto ex_reason = "Expected " + std::to_string(fmt_arg_count) + 
-							" arguments, but received " +
-							std::to_string(args_tuple->items.size());
-
-			YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
-			return false;
+		case ObjectType::Object: return "Object";
+		case ObjectType::Boolean: return "Boolean";
+		case ObjectType::Integer: return "Integer";
+		case ObjectType::Float: return "Float";
+		case ObjectType::String: return "String";
+		case ObjectType::Tuple: return "Tuple";
+		case ObjectType::List: return "List";
+		case ObjectType::Reference: return "Ref";
+		case ObjectType::StringView: return "StringView";
+		default: return "Unknown";
 		}
+	}
 
-		// Setting the number of used parameters
-		args_tuple->items_used = fmt_arg_count;
+	void __yosen_throw_arg_count_exception(size_t expected, size_t received)
+	{
+		auto ex_reason = "Expected " + std::to_string(expected) +
+						" arguments, but received " +
+						std::to_string(received);
 
-		va_list args;
-		va_start(args, fmt);
+		YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
+	}
 
-		for (size_t i = 0; i < fmt_arg_count; i++)
-		{
-			char arg_type = fmt[i];
-			switch (arg_type)
-			{
-			case 'i': {
-				int64_t* p_arg = va_arg(args, int64_t*);
-				YosenInteger* t_arg = reinterpret_cast<YosenInteger*>(args_tuple->items[i]);
-				if (strcmp(t_arg->runtime_name(), "Integer") != 0)
-				{
-					throw "Not an Integer";
-					return false;
-				}
-
-				*p_arg = t_arg->value;
-				break;
-			}
-			case 'f': {
-				double* p_arg = va_arg(args, double*);
-				YosenFloat* t_arg = reinterpret_cast<YosenFloat*>(args_tuple->items[i]);
-				if (strcmp(t_arg->runtime_name(), "Float") != 0)
-				{
-					throw "Not a Float";
-					return false;
-				}
-
-				*p_arg = t_arg->value;
-				break;
-			}
-			case 's': {
-				char** p_arg = va_arg(args, char**);
-				YosenString* t_arg = reinterpret_cast<YosenString*>(args_tuple->items[i]);
-				if (strcmp(t_arg->runtime_name(), "String") != 0)
-				{
-					throw "Not a String";
-					return false;
-				}
-
-				*p_arg = (char*)t_arg->value.c_str();
-				break;
-			}
-			case 'o': {
-				YosenObject** p_arg = va_arg(args, YosenObject**);
-				YosenObject* t_arg = args_tuple->items[i];
-				*p_arg = t_arg;
-				break;
-			}
-			default: {
-				int _ = va_arg(args, int);
-				printf("YosenArg_Parse::Warn: Unknown format argument '%c'\n", fmt[i]);
-				break;
-			}
-			}
-		}
+	void __yosen_throw_arg_type_exception(size_t idx, ObjectType expected, YosenObject* received)
+	{
+		auto ex_reason = "Argument " + std::to_string(idx + 1) + " expected to be of type " +
+						object_type_to_string(expected) + ", but received " +
+						received->runtime_name();
 
-		va_end(args);
-		return true;
+		YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
 	}
 }
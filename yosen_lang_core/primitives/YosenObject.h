@@ -5,6 +5,7 @@
 #include <functional>
 #include <vector>
 #include <map>
+#include <array>
 
 #ifdef __linux__
 	#include <cstring>
@@ -17,11 +18,33 @@ namespace yosen
 	class StackFrame;
 	class YosenObject;
 
-	using ys_static_native_fn_t		= std::function<YosenObject* (YosenObject*)>;
-	using ys_member_native_fn_t		= std::function<YosenObject* (YosenObject*, YosenObject*)>;
-	using ys_class_builder_fn_t		= std::function<YosenObject* (YosenObject*)>;
+	// Non-owning view over the arguments of a native function call.
+	// Points directly into the caller's parameter stack, so passing
+	// arguments to a native function doesn't allocate anything.
+	class YosenArgs
+	{
+	public:
+		YosenArgs() = default;
+		YosenArgs(YosenObject* const* data, size_t count) : m_data(data), m_count(count) {}
+
+		inline size_t size() const { return m_count; }
+		inline bool empty() const { return m_count == 0; }
+
+		inline YosenObject* operator[](size_t idx) const { return m_data[idx]; }
+
+		inline YosenObject* const* begin() const { return m_data; }
+		inline YosenObject* const* end() const { return m_data + m_count; }
+
+	private:
+		YosenObject* const* m_data = nullptr;
+		size_t m_count = 0;
+	};
+
+	using ys_static_native_fn_t		= YosenObject* (*)(YosenArgs);
+	using ys_member_native_fn_t		= YosenObject* (*)(YosenObject*, YosenArgs);
+	using ys_class_builder_fn_t		= std::function<YosenObject* (YosenArgs)>;
 	using ys_runtime_function_t		= std::pair<std::shared_ptr<StackFrame>, std::vector<unsigned short>>;
-	using ys_runtime_operator_fn_t	= std::function<YosenObject* (YosenObject*, YosenObject*)>;
+	using ys_runtime_operator_fn_t	= YosenObject* (*)(YosenObject*, YosenObject*);
 
 	enum class RuntimeOperator
 	{
@@ -38,11 +61,51 @@ namespace yosen
 		BoolOpAnd,
 	};
 
+	constexpr size_t RuntimeOperatorCount = static_cast<size_t>(RuntimeOperator::BoolOpAnd) + 1;
+
+	// Member native functions and runtime operators of the native types are
+	// stored in static per-type tables that are shared by all the instances.
+	using ys_member_native_table_t		= std::map<std::string, ys_member_native_fn_t>;
+	using ys_runtime_operator_table_t	= std::array<ys_runtime_operator_fn_t, RuntimeOperatorCount>;
+
+	// Builds a runtime operator table from a list of operator-function pairs
+	inline ys_runtime_operator_table_t make_runtime_operator_table(
+		std::initializer_list<std::pair<RuntimeOperator, ys_runtime_operator_fn_t>> operators)
+	{
+		ys_runtime_operator_table_t table = {};
+		for (auto& [op, fn] : operators)
+			table[static_cast<size_t>(op)] = fn;
+
+		return table;
+	}
+
+	// Compact type identifier stored in every object,
+	// allows type checks without comparing runtime names.
+	enum class ObjectType : uint8_t
+	{
+		Object,
+		Boolean,
+		Integer,
+		Float,
+		String,
+		Tuple,
+		List,
+		Reference,
+		StringView,
+
+		// Number of object types, not a type itself
+		Count,
+	};
+
 	class YosenObject
 	{
 		friend class YosenEnvironment;
+		friend YOSENAPI void __yosen_register_allocated_object(YosenObject* obj, size_t size);
+		friend YOSENAPI void __yosen_register_freed_object(YosenObject* obj);
 
 	public:
+		static constexpr ObjectType object_type = ObjectType::Object;
+
 		YOSENAPI YosenObject();
 		YOSENAPI virtual ~YosenObject();
 
@@ -58,6 +121,22 @@ namespace yosen
 		// Returns information about the instance
 		YOSENAPI std::string instance_info() const;
 
+		// Returns the compact type identifier of the object
+		inline ObjectType type() const { return m_type; }
+
+		// Returns whether or not the object is a shared immortal instance
+		// such as null, true or false that never gets deallocated.
+		inline bool is_immortal() const { return m_immortal; }
+
+		// Returns whether or not the object is of the given primitive type
+		template <typename T>
+		inline bool is() const { return m_type == T::object_type; }
+
+		// Casts the object to the given primitive type,
+		// the type should be checked with is<T>() beforehand.
+		template <typename T>
+		inline T* as() { return static_cast<T*>(this); }
+
 		// Adds a member function to the object
 		YOSENAPI virtual void add_member_native_function(const std::string& name, ys_member_native_fn_t fn);
 
@@ -65,7 +144,7 @@ namespace yosen
 		YOSENAPI virtual bool has_member_native_function(const std::string& name);
 
 		// Calls the native member function
-		YOSENAPI virtual YosenObject* call_member_native_function(const std::string& name, YosenObject* args);
+		YOSENAPI virtual YosenObject* call_member_native_function(const std::string& name, YosenArgs args);
 
 		// Adds a member function to the object
 		YOSENAPI virtual void add_member_runtime_function(const std::string& name, ys_runtime_function_t fn);
@@ -88,9 +167,6 @@ namespace yosen
 		// Sets the member variable given the name
 		YOSENAPI virtual void set_member_variable(const std::string& name, YosenObject* value);
 
-		// Adds a runtime operator function to the object
-		YOSENAPI void add_runtime_operator_function(RuntimeOperator op, ys_runtime_operator_fn_t fn);
-
 		// Calls an appropriate function according to the provided runtime operator
 		YOSENAPI YosenObject* call_runtime_operator_function(RuntimeOperator op, YosenObject* rhs);
 
@@ -102,29 +178,50 @@ namespace yosen
 		YOSENAPI void override_to_string_repr(const std::string& repr) { m_string_repr = repr; }
 
 	protected:
+		// Used by the primitive types to set their type identifier
+		YOSENAPI YosenObject(ObjectType type);
+
+		// Looks up a native member function in the instance's own functions,
+		// then in the type's static table, returns nullptr if not found.
+		YOSENAPI ys_member_native_fn_t find_member_native_function(const std::string& name);
+
+	protected:
+		ObjectType m_type = ObjectType::Object;
+		bool m_immortal = false;
+
+		// Size recorded by allocate_object for the allocation stats
+		uint32_t m_allocation_size = 0;
+
 		std::string m_string_repr;
 
 	protected:
 		std::string m_overriden_runtime_name;
 
+		// Static tables set by the native types
+		const ys_member_native_table_t* m_member_native_table = nullptr;
+		const ys_runtime_operator_table_t* m_runtime_operator_table = nullptr;
+
+		// Functions added to this specific instance
 		std::map<std::string, ys_member_native_fn_t> m_member_native_functions;
 		std::map<std::string, ys_runtime_function_t> m_member_runtime_functions;
 
-		std::map<RuntimeOperator, ys_runtime_operator_fn_t> m_runtime_operator_functions;
-
 		std::map<std::string, YosenObject*> m_member_variables;
-	};
 
-#define MEMBER_FUNCTION(fn) [this](YosenObject* self, YosenObject* args) { return fn(self, args); }
+	private:
+		static const ys_member_native_table_t s_member_native_functions;
+
+		static YosenObject* ref(YosenObject* self, YosenArgs args);
+	};
 
-	YOSENAPI void __yosen_register_allocated_object(void* obj);
+	YOSENAPI void __yosen_register_allocated_object(YosenObject* obj, size_t size);
+	YOSENAPI void __yosen_register_freed_object(YosenObject* obj);
 	YOSENAPI uint64_t __yosen_get_total_allocated_objects();
 
 	template<typename T, typename ...Args>
 	T* allocate_object(Args && ...args)
 	{
 		T* object = new T(std::forward<Args>(args)...);
-		__yosen_register_allocated_object(object);
+		__yosen_register_allocated_object(object, sizeof(T));
 
 #ifdef PROFILE_OBJECT_ALLOCATION
 		printf("YosenObject Allocated,  total object count: %zi\n", __yosen_get_total_allocated_objects());
@@ -134,7 +231,8 @@ namespace yosen
 	}
 	
 	YOSENAPI void free_object(YosenObject* obj);
-	YOSENAPI bool arg_parse(YosenObject* obj, const char* fmt, ...);
 
 	YOSENAPI extern YosenObject* YosenObject_Null;
+	YOSENAPI extern YosenObject* YosenObject_True;
+	YOSENAPI extern YosenObject* YosenObject_False;
 }
@@ -2,15 +2,15 @@
 
 namespace yosen
 {
-	YosenReference::YosenReference()
+	YosenReference::YosenReference() : YosenObject(object_type)
 	{
-		register_member_native_functions();
+		m_member_native_table = &s_member_native_functions;
 	}
 
 	YosenReference::YosenReference(YosenObject* obj)
-		: obj(obj)
+		: YosenObject(object_type), obj(obj)
 	{
-		register_member_native_functions();
+		m_member_native_table = &s_member_native_functions;
 	}
 
 	YosenReference::~YosenReference()
@@ -32,34 +32,28 @@ namespace yosen
 		return "Ref";
 	}
 
-	void YosenReference::register_member_native_functions()
-	{
-		add_member_native_function("obj", MEMBER_FUNCTION(get_obj));
-	}
+	const ys_member_native_table_t YosenReference::s_member_native_functions = {
+		{ "obj", get_obj },
+	};
 
-	YosenObject* YosenReference::get_obj(YosenObject* self, YosenObject* args)
+	YosenObject* YosenReference::get_obj(YosenObject* self, YosenArgs args)
 	{
-		arg_parse(args, "");
-
-		auto this_obj = static_cast<YosenReference*>(self);
+		auto this_obj = self->as<YosenReference>();
 		return this_obj->obj->clone();
 	}
 
 	bool YosenReference::has_member_native_function(const std::string& name)
 	{
-		if (m_member_native_functions.find(name) != m_member_native_functions.end())
+		if (find_member_native_function(name))
 			return true;
 
 		return obj->has_member_native_function(name);
 	}
 
-	YosenObject* YosenReference::call_member_native_function(const std::string& name, YosenObject* args)
+	YosenObject* YosenReference::call_member_native_function(const std::string& name, YosenArgs args)
 	{
-		if (has_member_native_function(name))
-		{
-			auto fn = m_member_native_functions[name];
+		if (auto fn = find_member_native_function(name))
 			return fn(this, args);
-		}
 
 		return obj->call_member_native_function(name, args);
 	}
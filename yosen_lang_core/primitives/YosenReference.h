@@ -6,6 +6,8 @@ namespace yosen
 	class YosenReference : public YosenObject
 	{
 	public:
+		static constexpr ObjectType object_type = ObjectType::Reference;
+
 		YOSENAPI YosenReference();
 		YOSENAPI YosenReference(YosenObject* obj);
 		YOSENAPI ~YosenReference();
@@ -17,7 +19,7 @@ namespace yosen
 		YosenObject* obj = nullptr;
 
 		YOSENAPI bool has_member_native_function(const std::string& name) override;
-		YOSENAPI YosenObject* call_member_native_function(const std::string& name, YosenObject* args) override;
+		YOSENAPI YosenObject* call_member_native_function(const std::string& name, YosenArgs args) override;
 
 		YOSENAPI bool has_member_runtime_function(const std::string& name) override;
 		YOSENAPI ys_runtime_function_t get_member_runtime_function(const std::string& name) override;
@@ -27,8 +29,8 @@ namespace yosen
 		YOSENAPI virtual void set_member_variable(const std::string& name, YosenObject* value) override;
 
 	private:
-		void register_member_native_functions();
+		static const ys_member_native_table_t s_member_native_functions;
 
-		YosenObject* get_obj(YosenObject* self, YosenObject* args);
+		static YosenObject* get_obj(YosenObject* self, YosenArgs args);
 	};
 }
@@ -1,19 +1,22 @@
 #include "YosenString.h"
+#include "YosenStringView.h"
+#include "YosenList.h"
+#include "StringKernels.h"
 #include <YosenEnvironment.h>
 
 namespace yosen
 {
-	YosenString::YosenString()
+	YosenString::YosenString() : YosenObject(object_type)
 	{
-		register_member_native_functions();
-		register_runtime_operator_functions();
+		m_member_native_table = &s_member_native_functions;
+		m_runtime_operator_table = &s_runtime_operator_functions;
 	}
 
 	YosenString::YosenString(const std::string& val)
-		: value(val)
+		: YosenObject(object_type), value(val)
 	{
-		register_member_native_functions();
-		register_runtime_operator_functions();
+		m_member_native_table = &s_member_native_functions;
+		m_runtime_operator_table = &s_runtime_operator_functions;
 	}
 	
 	YosenObject* YosenString::clone()
@@ -32,32 +35,34 @@ namespace yosen
 		return "String";
 	}
 
-	void YosenString::register_member_native_functions()
+	const ys_member_native_table_t YosenString::s_member_native_functions = {
+		{ "length",	length },
+		{ "reverse",	reverse },
+		{ "append",	append },
+		{ "substr",	substr },
+		{ "contains",  contains },
+		{ "find",		find },
+		{ "remove",	remove },
+		{ "clear",		clear },
+		{ "is_empty",  is_empty },
+		{ "view",		view },
+		{ "split",		split },
+		{ "count",		count },
+		{ "replace_all", replace_all },
+		{ "to_upper",	to_upper },
+		{ "to_lower",	to_lower },
+		{ "is_ascii",	is_ascii },
+	};
+
+	YosenObject* YosenString::length(YosenObject* self, YosenArgs args)
 	{
-		add_member_native_function("length",	MEMBER_FUNCTION(length));
-		add_member_native_function("reverse",	MEMBER_FUNCTION(reverse));
-		add_member_native_function("append",	MEMBER_FUNCTION(append));
-		add_member_native_function("substr",	MEMBER_FUNCTION(substr));
-		add_member_native_function("contains",  MEMBER_FUNCTION(contains));
-		add_member_native_function("find",		MEMBER_FUNCTION(find));
-		add_member_native_function("remove",	MEMBER_FUNCTION(remove));
-		add_member_native_function("clear",		MEMBER_FUNCTION(clear));
-		add_member_native_function("is_empty",  MEMBER_FUNCTION(is_empty));
-	}
-
-	YosenObject* YosenString::length(YosenObject* self, YosenObject* args)
-	{
-		arg_parse(args, "");
-
-		auto this_obj = static_cast<YosenString*>(self);
+		auto this_obj = self->as<YosenString>();
 		return allocate_object<YosenInteger>((int64_t)this_obj->value.size());
 	}
 
-	YosenObject* YosenString::reverse(YosenObject* self, YosenObject* args)
+	YosenObject* YosenString::reverse(YosenObject* self, YosenArgs args)
 	{
-		arg_parse(args, "");
-
-		auto this_obj = static_cast<YosenString*>(self);
+		auto this_obj = self->as<YosenString>();
 
 		std::string val_copy(this_obj->value);
 		std::reverse(val_copy.begin(), val_copy.end());
@@ -65,70 +70,72 @@ namespace yosen
 		return allocate_object<YosenString>(val_copy);
 	}
 
-	YosenObject* YosenString::append(YosenObject* self, YosenObject* args)
+	YosenObject* YosenString::append(YosenObject* self, YosenArgs args)
 	{
 		YosenObject* rhs;
-		arg_parse(args, "o", &rhs);
+		if (!arg_parse(args, rhs))
+			return nullptr;
 
-		if (strcmp(rhs->runtime_name(), "String") != 0)
+		std::string_view rhs_val;
+		if (!get_string_contents(rhs, rhs_val))
 		{
 			auto ex_reason = std::string("cannot append object of type ") + rhs->runtime_name() + " to a string";
 			YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
 			return nullptr;
 		}
 
-		auto this_obj = static_cast<YosenString*>(self);
-		auto rhs_obj = static_cast<YosenString*>(rhs);
-
-		this_obj->value.append(rhs_obj->value);
-		return YosenObject_Null->clone();
+		auto this_obj = self->as<YosenString>();
+		this_obj->value.append(rhs_val);
+		return YosenObject_Null;
 	}
 
-	YosenObject* YosenString::remove(YosenObject* self, YosenObject* args)
+	YosenObject* YosenString::remove(YosenObject* self, YosenArgs args)
 	{
-		char* substr = nullptr;
-		arg_parse(args, "s", &substr);
-
-		if (!substr)
+		std::string_view substr;
+		if (!arg_parse(args, substr))
 			return nullptr;
 
-		auto this_obj = static_cast<YosenString*>(self);
-		size_t idx = this_obj->value.find(substr);
+		auto this_obj = self->as<YosenString>();
+		size_t idx = string_kernels::find(this_obj->value, substr);
 
 		if (idx == std::string::npos)
-			return allocate_object<YosenBoolean>(false);
+			return get_boolean_object(false);
 
-		this_obj->value.erase(idx, strlen(substr));
-		return allocate_object<YosenBoolean>(true);
+		this_obj->value.erase(idx, substr.size());
+		return get_boolean_object(true);
 	}
 
-	YosenObject* YosenString::clear(YosenObject* self, YosenObject* args)
+	YosenObject* YosenString::clear(YosenObject* self, YosenArgs args)
 	{
-		arg_parse(args, "");
-
-		auto this_obj = static_cast<YosenString*>(self);
+		auto this_obj = self->as<YosenString>();
 		this_obj->value.clear();
 
-		return YosenObject_Null->clone();
+		return YosenObject_Null;
 	}
 
-	YosenObject* YosenString::is_empty(YosenObject* self, YosenObject* args)
+	YosenObject* YosenString::is_empty(YosenObject* self, YosenArgs args)
 	{
-		arg_parse(args, "");
-
-		auto this_obj = static_cast<YosenString*>(self);
+		auto this_obj = self->as<YosenString>();
 		bool result = this_obj->value.empty();
 		
-		return allocate_object<YosenBoolean>(result);
+		return get_boolean_object(result);
+	}
+
+	YosenObject* YosenString::view(YosenObject* self, YosenArgs args)
+	{
+		// The string is copied once, slices and splits of the view share the copy
+		auto this_obj = self->as<YosenString>();
+		return YosenStringView::from_string(this_obj->value);
 	}
 
-	YosenObject* YosenString::substr(YosenObject* self, YosenObject* args)
+	YosenObject* YosenString::substr(YosenObject* self, YosenArgs args)
 	{
 		int64_t start = 0;
 		int64_t end = 0;
-		arg_parse(args, "ii", &start, &end);
+		if (!arg_parse(args, start, end))
+			return nullptr;
 
-		auto this_obj = static_cast<YosenString*>(self);
+		auto this_obj = self->as<YosenString>();
 
 		if (start < 0 || start >= (int64_t)this_obj->value.size())
 		{
@@ -149,30 +156,31 @@ namespace yosen
 		return allocate_object<YosenString>(new_string);
 	}
 
-	YosenObject* YosenString::contains(YosenObject* self, YosenObject* args)
+	YosenObject* YosenString::contains(YosenObject* self, YosenArgs args)
 	{
-		char* substr = nullptr;
-		arg_parse(args, "s", &substr);
-
-		if (!substr)
+		std::string_view substr;
+		if (!arg_parse(args, substr))
 			return nullptr;
 
-		auto this_obj = static_cast<YosenString*>(self);
+		auto this_obj = self->as<YosenString>();
 
-		bool result = this_obj->value.find(substr) != std::string::npos;
-		return allocate_object<YosenBoolean>(result);
+		bool result = string_kernels::find(this_obj->value, substr) != std::string::npos;
+		return get_boolean_object(result);
 	}
 
-	YosenObject* YosenString::find(YosenObject* self, YosenObject* args)
+	YosenObject* YosenString::find(YosenObject* self, YosenArgs args)
 	{
-		char* substr = nullptr;
-		arg_parse(args, "s", &substr);
+		std::string_view substr;
+		if (!arg_parse(args, substr))
+			return nullptr;
 
-		if (!substr)
+		// An optional second argument specifies where to start searching
+		int64_t start = 0;
+		if (args.size() > 1 && !arg_parse(args, substr, start))
 			return nullptr;
 
-		auto this_obj = static_cast<YosenString*>(self);
-		size_t idx = this_obj->value.find(substr);
+		auto this_obj = self->as<YosenString>();
+		size_t idx = string_kernels::find(this_obj->value, substr, (size_t)std::max<int64_t>(start, 0));
 
 		int64_t result = -1;
 		if (idx != std::string::npos)
@@ -181,16 +189,94 @@ namespace yosen
 		return allocate_object<YosenInteger>(result);
 	}
 	
-	void YosenString::register_runtime_operator_functions()
+	// Throws an exception if the substring argument of a string function is empty
+	static bool check_substring_not_empty(std::string_view substr, const char* fn_name)
+	{
+		if (!substr.empty())
+			return true;
+
+		auto ex_reason = std::string("string::") + fn_name + "() - substring cannot be empty";
+		YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
+		return false;
+	}
+
+	YosenObject* YosenString::split(YosenObject* self, YosenArgs args)
+	{
+		auto this_obj = self->as<YosenString>();
+		std::vector<std::string_view> parts;
+
+		// Without a separator the string is split on runs of whitespace
+		if (args.empty())
+			parts = string_kernels::split_whitespace(this_obj->value);
+		else
+		{
+			std::string_view separator;
+			if (!arg_parse(args, separator) || !check_substring_not_empty(separator, "split"))
+				return nullptr;
+
+			parts = string_kernels::split(this_obj->value, separator);
+		}
+
+		std::vector<YosenObject*> items;
+		items.reserve(parts.size());
+
+		for (auto& part : parts)
+			items.push_back(allocate_object<YosenString>(std::string(part)));
+
+		return allocate_object<YosenList>(items);
+	}
+
+	YosenObject* YosenString::count(YosenObject* self, YosenArgs args)
 	{
-		add_runtime_operator_function(RuntimeOperator::BinOpAdd,		MEMBER_FUNCTION(operator_add));
-		add_runtime_operator_function(RuntimeOperator::BoolOpEqu,		MEMBER_FUNCTION(operator_equ));
-		add_runtime_operator_function(RuntimeOperator::BoolOpNotEqu,	MEMBER_FUNCTION(operator_notequ));
+		std::string_view substr;
+		if (!arg_parse(args, substr) || !check_substring_not_empty(substr, "count"))
+			return nullptr;
+
+		auto this_obj = self->as<YosenString>();
+		return allocate_object<YosenInteger>((int64_t)string_kernels::count(this_obj->value, substr));
+	}
+
+	YosenObject* YosenString::replace_all(YosenObject* self, YosenArgs args)
+	{
+		std::string_view from, to;
+		if (!arg_parse(args, from, to) || !check_substring_not_empty(from, "replace_all"))
+			return nullptr;
+
+		auto this_obj = self->as<YosenString>();
+		return allocate_object<YosenString>(string_kernels::replace_all(this_obj->value, from, to));
 	}
 
+	YosenObject* YosenString::to_upper(YosenObject* self, YosenArgs args)
+	{
+		auto result = allocate_object<YosenString>(self->as<YosenString>()->value);
+		string_kernels::to_upper(result->value);
+
+		return result;
+	}
+
+	YosenObject* YosenString::to_lower(YosenObject* self, YosenArgs args)
+	{
+		auto result = allocate_object<YosenString>(self->as<YosenString>()->value);
+		string_kernels::to_lower(result->value);
+
+		return result;
+	}
+
+	YosenObject* YosenString::is_ascii(YosenObject* self, YosenArgs args)
+	{
+		auto this_obj = self->as<YosenString>();
+		return get_boolean_object(string_kernels::is_ascii(this_obj->value));
+	}
+	
+	const ys_runtime_operator_table_t YosenString::s_runtime_operator_functions = make_runtime_operator_table({
+		{ RuntimeOperator::BinOpAdd,		operator_add },
+		{ RuntimeOperator::BoolOpEqu,		operator_equ },
+		{ RuntimeOperator::BoolOpNotEqu,	operator_notequ },
+	});
+
 	YosenObject* YosenString::operator_add(YosenObject* lhs, YosenObject* rhs)
 	{
-		auto left_string  = static_cast<YosenString*>(lhs)->value;
+		auto left_string  = lhs->as<YosenString>()->value;
 		auto right_string = rhs->to_string();
 
 		auto result_string = left_string + right_string;
@@ -200,31 +286,31 @@ namespace yosen
 
 	YosenObject* YosenString::operator_equ(YosenObject* lhs, YosenObject* rhs)
 	{
-		if (strcmp(rhs->runtime_name(), "String") != 0)
+		std::string_view right_val;
+		if (!get_string_contents(rhs, right_val))
 		{
 			auto ex_reason = std::string("cannot compare objects of type ") + rhs->runtime_name() + " and String";
 			YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
 			return nullptr;
 		}
 
-		auto left_val = static_cast<YosenString*>(lhs)->value;
-		auto right_val = static_cast<YosenString*>(rhs)->value;
+		auto& left_val = lhs->as<YosenString>()->value;
 
-		return allocate_object<YosenBoolean>(left_val == right_val);
+		return get_boolean_object(left_val == right_val);
 	}
 	
 	YosenObject* YosenString::operator_notequ(YosenObject* lhs, YosenObject* rhs)
 	{
-		if (strcmp(rhs->runtime_name(), "String") != 0)
+		std::string_view right_val;
+		if (!get_string_contents(rhs, right_val))
 		{
 			auto ex_reason = std::string("cannot compare objects of type ") + rhs->runtime_name() + " and String";
 			YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
 			return nullptr;
 		}
 
-		auto left_val = static_cast<YosenString*>(lhs)->value;
-		auto right_val = static_cast<YosenString*>(rhs)->value;
+		auto& left_val = lhs->as<YosenString>()->value;
 
-		return allocate_object<YosenBoolean>(left_val != right_val);
+		return get_boolean_object(left_val != right_val);
 	}
 }
@@ -6,6 +6,8 @@ namespace yosen
 	class YosenString : public YosenObject
 	{
 	public:
+		static constexpr ObjectType object_type = ObjectType::String;
+
 		YOSENAPI YosenString();
 		YOSENAPI YosenString(const std::string& val);
 
@@ -16,23 +18,30 @@ namespace yosen
 		std::string value = "";
 		
 	private:
-		void register_member_native_functions();
+		static const ys_member_native_table_t s_member_native_functions;
 
-		YosenObject* length(YosenObject* self, YosenObject* args);
-		YosenObject* reverse(YosenObject* self, YosenObject* args);
-		YosenObject* append(YosenObject* self, YosenObject* args);
-		YosenObject* substr(YosenObject* self, YosenObject* args);
-		YosenObject* contains(YosenObject* self, YosenObject* args);
-		YosenObject* find(YosenObject* self, YosenObject* args);
-		YosenObject* remove(YosenObject* self, YosenObject* args);
-		YosenObject* clear(YosenObject* self, YosenObject* args);
-		YosenObject* is_empty(YosenObject* self, YosenObject* args);
+		static YosenObject* length(YosenObject* self, YosenArgs args);
+		static YosenObject* reverse(YosenObject* self, YosenArgs args);
+		static YosenObject* append(YosenObject* self, YosenArgs args);
+		static YosenObject* substr(YosenObject* self, YosenArgs args);
+		static YosenObject* contains(YosenObject* self, YosenArgs args);
+		static YosenObject* find(YosenObject* self, YosenArgs args);
+		static YosenObject* remove(YosenObject* self, YosenArgs args);
+		static YosenObject* clear(YosenObject* self, YosenArgs args);
+		static YosenObject* is_empty(YosenObject* self, YosenArgs args);
+		static YosenObject* view(YosenObject* self, YosenArgs args);
+		static YosenObject* split(YosenObject* self, YosenArgs args);
+		static YosenObject* count(YosenObject* self, YosenArgs args);
+		static YosenObject* replace_all(YosenObject* self, YosenArgs args);
+		static YosenObject* to_upper(YosenObject* self, YosenArgs args);
+		static YosenObject* to_lower(YosenObject* self, YosenArgs args);
+		static YosenObject* is_ascii(YosenObject* self, YosenArgs args);
 
 	private:
-		void register_runtime_operator_functions();
+		static const ys_runtime_operator_table_t s_runtime_operator_functions;
 
-		YosenObject* operator_add(YosenObject* lhs, YosenObject* rhs);
-		YosenObject* operator_equ(YosenObject* lhs, YosenObject* rhs);
-		YosenObject* operator_notequ(YosenObject* lhs, YosenObject* rhs);
+		static YosenObject* operator_add(YosenObject* lhs, YosenObject* rhs);
+		static YosenObject* operator_equ(YosenObject* lhs, YosenObject* rhs);
+		static YosenObject* operator_notequ(YosenObject* lhs, YosenObject* rhs);
 	};
 }
@@ -0,0 +1,288 @@
+#include "YosenStringView.h"
+#include "YosenList.h"
+#include "StringKernels.h"
+#include <YosenEnvironment.h>
+#include <charconv>
+
+namespace yosen
+{
+	YosenStringView::YosenStringView() : YosenObject(object_type)
+	{
+		m_member_native_table = &s_member_native_functions;
+		m_runtime_operator_table = &s_runtime_operator_functions;
+	}
+
+	YosenStringView::YosenStringView(std::shared_ptr<const void> owner, std::string_view view)
+		: YosenObject(object_type), owner(std::move(owner)), value(view)
+	{
+		m_member_native_table = &s_member_native_functions;
+		m_runtime_operator_table = &s_runtime_operator_functions;
+	}
+
+	YosenStringView* YosenStringView::from_string(const std::string& str)
+	{
+		auto buffer = std::make_shared<const std::string>(str);
+		return allocate_object<YosenStringView>(buffer, std::string_view(*buffer));
+	}
+
+	YosenObject* YosenStringView::clone()
+	{
+		return allocate_object<YosenStringView>(owner, value);
+	}
+
+	std::string YosenStringView::to_string()
+	{
+		return std::string(value);
+	}
+
+	const char* YosenStringView::runtime_name() const
+	{
+		return "StringView";
+	}
+
+	YosenStringView* YosenStringView::subview(std::string_view view) const
+	{
+		return allocate_object<YosenStringView>(owner, view);
+	}
+
+	const ys_member_native_table_t YosenStringView::s_member_native_functions = {
+		{ "length",		length },
+		{ "find",			find },
+		{ "contains",		contains },
+		{ "starts_with",	starts_with },
+		{ "ends_with",	ends_with },
+		{ "slice",		slice },
+		{ "split",		split },
+		{ "count",		count },
+		{ "trim",			trim },
+		{ "to_int",		to_int },
+		{ "to_float",		to_float },
+		{ "to_str",		to_str },
+		{ "is_empty",		is_empty },
+	};
+
+	YosenObject* YosenStringView::length(YosenObject* self, YosenArgs args)
+	{
+		auto this_obj = self->as<YosenStringView>();
+		return allocate_object<YosenInteger>((int64_t)this_obj->value.size());
+	}
+
+	YosenObject* YosenStringView::find(YosenObject* self, YosenArgs args)
+	{
+		std::string_view substr;
+		if (!arg_parse(args, substr))
+			return nullptr;
+
+		// An optional second argument specifies where to start searching
+		int64_t start = 0;
+		if (args.size() > 1 && !arg_parse(args, substr, start))
+			return nullptr;
+
+		auto this_obj = self->as<YosenStringView>();
+		size_t idx = string_kernels::find(this_obj->value, substr, (size_t)std::max<int64_t>(start, 0));
+
+		int64_t result = -1;
+		if (idx != std::string_view::npos)
+			result = (int64_t)idx;
+
+		return allocate_object<YosenInteger>(result);
+	}
+
+	YosenObject* YosenStringView::contains(YosenObject* self, YosenArgs args)
+	{
+		std::string_view substr;
+		if (!arg_parse(args, substr))
+			return nullptr;
+
+		auto this_obj = self->as<YosenStringView>();
+		return get_boolean_object(string_kernels::find(this_obj->value, substr) != std::string_view::npos);
+	}
+
+	YosenObject* YosenStringView::starts_with(YosenObject* self, YosenArgs args)
+	{
+		std::string_view prefix;
+		if (!arg_parse(args, prefix))
+			return nullptr;
+
+		auto this_obj = self->as<YosenStringView>();
+		return get_boolean_object(this_obj->value.substr(0, prefix.size()) == prefix);
+	}
+
+	YosenObject* YosenStringView::ends_with(YosenObject* self, YosenArgs args)
+	{
+		std::string_view suffix;
+		if (!arg_parse(args, suffix))
+			return nullptr;
+
+		auto this_obj = self->as<YosenStringView>();
+		auto& value = this_obj->value;
+
+		bool result = value.size() >= suffix.size() &&
+			value.substr(value.size() - suffix.size()) == suffix;
+
+		return get_boolean_object(result);
+	}
+
+	YosenObject* YosenStringView::slice(YosenObject* self, YosenArgs args)
+	{
+		int64_t start = 0;
+		int64_t end = 0;
+		if (!arg_parse(args, start, end))
+			return nullptr;
+
+		auto this_obj = self->as<YosenStringView>();
+
+		if (start < 0 || end < start || end > (int64_t)this_obj->value.size())
+		{
+			auto ex_reason = "StringView::slice() - range out of bounds";
+			YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
+			return nullptr;
+		}
+
+		return this_obj->subview(this_obj->value.substr(start, end - start));
+	}
+
+	YosenObject* YosenStringView::split(YosenObject* self, YosenArgs args)
+	{
+		auto this_obj = self->as<YosenStringView>();
+		std::vector<std::string_view> parts;
+
+		// Without a separator the view is split on runs of whitespace
+		if (args.empty())
+			parts = string_kernels::split_whitespace(this_obj->value);
+		else
+		{
+			std::string_view separator;
+			if (!arg_parse(args, separator))
+				return nullptr;
+
+			if (separator.empty())
+			{
+				auto ex_reason = "StringView::split() - separator cannot be empty";
+				YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
+				return nullptr;
+			}
+
+			parts = string_kernels::split(this_obj->value, separator);
+		}
+
+		std::vector<YosenObject*> fields;
+		fields.reserve(parts.size());
+
+		for (auto& part : parts)
+			fields.push_back(this_obj->subview(part));
+
+		return allocate_object<YosenList>(fields);
+	}
+
+	YosenObject* YosenStringView::count(YosenObject* self, YosenArgs args)
+	{
+		std::string_view substr;
+		if (!arg_parse(args, substr))
+			return nullptr;
+
+		if (substr.empty())
+		{
+			auto ex_reason = "StringView::count() - substring cannot be empty";
+			YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
+			return nullptr;
+		}
+
+		auto this_obj = self->as<YosenStringView>();
+		return allocate_object<YosenInteger>((int64_t)string_kernels::count(this_obj->value, substr));
+	}
+
+	YosenObject* YosenStringView::trim(YosenObject* self, YosenArgs args)
+	{
+		auto this_obj = self->as<YosenStringView>();
+		auto value = this_obj->value;
+
+		constexpr std::string_view whitespace = " \t\r\n\v\f";
+
+		size_t start = value.find_first_not_of(whitespace);
+		if (start == std::string_view::npos)
+			return this_obj->subview(value.substr(0, 0));
+
+		size_t end = value.find_last_not_of(whitespace);
+		return this_obj->subview(value.substr(start, end - start + 1));
+	}
+
+	YosenObject* YosenStringView::to_int(YosenObject* self, YosenArgs args)
+	{
+		auto value = self->as<YosenStringView>()->value;
+
+		// Returns null if the whole view isn't a valid integer, same as int()
+		int64_t result = 0;
+		auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), result);
+
+		if (ec != std::errc() || end != value.data() + value.size() || value.empty())
+			return YosenObject_Null;
+
+		return allocate_object<YosenInteger>(result);
+	}
+
+	YosenObject* YosenStringView::to_float(YosenObject* self, YosenArgs args)
+	{
+		auto value = self->as<YosenStringView>()->value;
+
+		double result = 0;
+		auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), result);
+
+		if (ec != std::errc() || end != value.data() + value.size() || value.empty())
+			return YosenObject_Null;
+
+		return allocate_object<YosenFloat>(result);
+	}
+
+	YosenObject* YosenStringView::to_str(YosenObject* self, YosenArgs args)
+	{
+		auto this_obj = self->as<YosenStringView>();
+		return allocate_object<YosenString>(std::string(this_obj->value));
+	}
+
+	YosenObject* YosenStringView::is_empty(YosenObject* self, YosenArgs args)
+	{
+		auto this_obj = self->as<YosenStringView>();
+		return get_boolean_object(this_obj->value.empty());
+	}
+
+	const ys_runtime_operator_table_t YosenStringView::s_runtime_operator_functions = make_runtime_operator_table({
+		{ RuntimeOperator::BinOpAdd,		operator_add },
+		{ RuntimeOperator::BoolOpEqu,		operator_equ },
+		{ RuntimeOperator::BoolOpNotEqu,	operator_notequ },
+	});
+
+	YosenObject* YosenStringView::operator_add(YosenObject* lhs, YosenObject* rhs)
+	{
+		auto result_string = std::string(lhs->as<YosenStringView>()->value);
+		result_string += rhs->to_string();
+
+		return allocate_object<YosenString>(result_string);
+	}
+
+	YosenObject* YosenStringView::operator_equ(YosenObject* lhs, YosenObject* rhs)
+	{
+		std::string_view right_val;
+		if (!get_string_contents(rhs, right_val))
+		{
+			auto ex_reason = std::string("cannot compare objects of type ") + rhs->runtime_name() + " and StringView";
+			YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
+			return nullptr;
+		}
+
+		return get_boolean_object(lhs->as<YosenStringView>()->value == right_val);
+	}
+
+	YosenObject* YosenStringView::operator_notequ(YosenObject* lhs, YosenObject* rhs)
+	{
+		std::string_view right_val;
+		if (!get_string_contents(rhs, right_val))
+		{
+			auto ex_reason = std::string("cannot compare objects of type ") + rhs->runtime_name() + " and StringView";
+			YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
+			return nullptr;
+		}
+
+		return get_boolean_object(lhs->as<YosenStringView>()->value != right_val);
+	}
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include "YosenString.h"
+#include <memory>
+#include <string_view>
+
+namespace yosen
+{
+	// Read-only slice of a string buffer that is kept alive by a shared owner.
+	// Slicing, splitting and searching a view create new views over the same
+	// buffer, the characters are only copied when converted to a string.
+	class YosenStringView : public YosenObject
+	{
+	public:
+		static constexpr ObjectType object_type = ObjectType::StringView;
+
+		YOSENAPI YosenStringView();
+		YOSENAPI YosenStringView(std::shared_ptr<const void> owner, std::string_view view);
+
+		// Creates a view over a copy of the string that is shared by all of its sub-views
+		YOSENAPI static YosenStringView* from_string(const std::string& str);
+
+		YOSENAPI YosenObject* clone() override;
+		YOSENAPI std::string to_string() override;
+		YOSENAPI const char* runtime_name() const override;
+
+		// Keeps the buffer referenced by the view alive
+		std::shared_ptr<const void> owner;
+		std::string_view value;
+
+	private:
+		// Creates a view over part of this view's buffer
+		YosenStringView* subview(std::string_view view) const;
+
+	private:
+		static const ys_member_native_table_t s_member_native_functions;
+
+		static YosenObject* length(YosenObject* self, YosenArgs args);
+		static YosenObject* find(YosenObject* self, YosenArgs args);
+		static YosenObject* contains(YosenObject* self, YosenArgs args);
+		static YosenObject* starts_with(YosenObject* self, YosenArgs args);
+		static YosenObject* ends_with(YosenObject* self, YosenArgs args);
+		static YosenObject* slice(YosenObject* self, YosenArgs args);
+		static YosenObject* split(YosenObject* self, YosenArgs args);
+		static YosenObject* count(YosenObject* self, YosenArgs args);
+		static YosenObject* trim(YosenObject* self, YosenArgs args);
+		static YosenObject* to_int(YosenObject* self, YosenArgs args);
+		static YosenObject* to_float(YosenObject* self, YosenArgs args);
+		static YosenObject* to_str(YosenObject* self, YosenArgs args);
+		static YosenObject* is_empty(YosenObject* self, YosenArgs args);
+
+	private:
+		static const ys_runtime_operator_table_t s_runtime_operator_functions;
+
+		static YosenObject* operator_add(YosenObject* lhs, YosenObject* rhs);
+		static YosenObject* operator_equ(YosenObject* lhs, YosenObject* rhs);
+		static YosenObject* operator_notequ(YosenObject* lhs, YosenObject* rhs);
+	};
+
+	// Reads the characters of a String or StringView object without
+	// copying them, returns false if the object is neither of the two.
+	inline bool get_string_contents(YosenObject* obj, std::string_view& out)
+	{
+		if (obj->is<YosenString>())
+			out = obj->as<YosenString>()->value;
+		else if (obj->is<YosenStringView>())
+			out = obj->as<YosenStringView>()->value;
+		else
+			return false;
+
+		return true;
+	}
+}
@@ -2,15 +2,13 @@
 
 namespace yosen
 {
-	YosenTuple::YosenTuple()
+	YosenTuple::YosenTuple() : YosenObject(object_type)
 	{
-		register_member_native_functions();
 	}
 
 	YosenTuple::YosenTuple(const std::vector<YosenObject*>& items)
-		: items(items)
+		: YosenObject(object_type), items(items)
 	{
-		register_member_native_functions();
 	}
 
 	YosenTuple::~YosenTuple()
@@ -47,8 +45,4 @@ namespace yosen
 	{
 		return "Tuple";
 	}
-
-	void YosenTuple::register_member_native_functions()
-	{
-	}
 }
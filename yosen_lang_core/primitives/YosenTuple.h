@@ -6,6 +6,8 @@ namespace yosen
 	class YosenTuple : public YosenObject
 	{
 	public:
+		static constexpr ObjectType object_type = ObjectType::Tuple;
+
 		YOSENAPI YosenTuple();
 		YOSENAPI YosenTuple(const std::vector<YosenObject*>& items);
 		YOSENAPI ~YosenTuple();
@@ -15,11 +17,5 @@ namespace yosen
 		YOSENAPI const char* runtime_name() const override;
 
 		std::vector<YosenObject*> items;
-
-		// Important for interpreter internals
-		size_t items_used = 0;
-
-	private:
-		void register_member_native_functions();
 	};
 }
@@ -3,6 +3,11 @@
 #include "YosenInteger.h"
 #include "YosenFloat.h"
 #include "YosenString.h"
+#include "YosenStringView.h"
+#include "StringKernels.h"
 #include "YosenTuple.h"
 #include "YosenList.h"
-#include "YosenReference.h"
\ No newline at end of file
+#include "YosenReference.h"
+#include "ArgParse.h"
+#include "NativeBinding.h"
+#include "AllocationStats.h"
\ No newline at end of file
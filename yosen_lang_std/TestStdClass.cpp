@@ -1,22 +1,23 @@
 #include "TestStdClass.h"
 
-YosenObject* test_std_class_builder(YosenObject* args)
+YosenObject* test_std_class_builder(YosenArgs args)
 {
 	return allocate_object<TestStdClass>();
 }
 
-YosenObject* _ys_std_println(YosenObject* args)
+YosenObject* _ys_std_println(YosenArgs args)
 {
 	YosenObject* obj;
-	arg_parse(args, "o", &obj);
+	if (!arg_parse(args, obj))
+		return nullptr;
 
 	printf("%s\n", obj->to_string().c_str());
-	return YosenObject_Null->clone();
+	return YosenObject_Null;
 }
 
 TestStdClass::TestStdClass()
 {
-	add_member_native_function("test_fn", MEMBER_FUNCTION(test_fn));
+	add_member_native_function("test_fn", test_fn);
 }
 
 YosenObject* TestStdClass::clone()
@@ -34,8 +35,8 @@ const char* TestStdClass::runtime_name() const
 	return "TestStdClass";
 }
 
-YosenObject* TestStdClass::test_fn(YosenObject* self, YosenObject* args)
+YosenObject* TestStdClass::test_fn(YosenObject* self, YosenArgs args)
 {
 	printf("YEET TEST WORKING!\n");
-	return YosenObject_Null->clone();
+	return YosenObject_Null;
 }
@@ -12,7 +12,7 @@ public:
 	const char* runtime_name() const override;
 
 private:
-	YosenObject* test_fn(YosenObject* self, YosenObject* args);
+	static YosenObject* test_fn(YosenObject* self, YosenArgs args);
 };
 
-YosenObject* test_std_class_builder(YosenObject* args);
+YosenObject* test_std_class_builder(YosenArgs args);
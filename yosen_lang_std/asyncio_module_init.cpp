@@ -0,0 +1,20 @@
+#include "yosen_std_asyncio.h"
+
+EXTERNC YOSENEXPORT void _ys_init_module()
+{
+	auto& env = YosenEnvironment::get();
+
+	env.start_module_namespace("asyncio");
+	env.register_static_native_function("spawn", _ys_std_asyncio_spawn);
+	env.register_static_native_function("await", _ys_std_asyncio_await);
+	env.register_native<&_ys_std_asyncio_run>("run");
+	env.register_native<&_ys_std_asyncio_sleep>("sleep");
+	env.register_native<&_ys_std_asyncio_pipe>("pipe");
+	env.register_native<&_ys_std_asyncio_read>("read");
+	env.register_native<&_ys_std_asyncio_write>("write");
+	env.register_native<&_ys_std_asyncio_close>("close");
+	env.register_native<&_ys_std_asyncio_listen>("listen");
+	env.register_native<&_ys_std_asyncio_accept>("accept");
+	env.register_native<&_ys_std_asyncio_connect>("connect");
+	env.end_module_namespace();
+}
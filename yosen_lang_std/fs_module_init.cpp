@@ -0,0 +1,16 @@
+#include "yosen_std_fs.h"
+
+EXTERNC YOSENEXPORT void _ys_init_module()
+{
+	auto& env = YosenEnvironment::get();
+
+	env.start_module_namespace("fs");
+	env.register_static_native_function("open_reader", _ys_std_fs_open_reader);
+	env.register_static_native_function("open_writer", _ys_std_fs_open_writer);
+	env.register_static_native_function("for_each_line", _ys_std_fs_for_each_line);
+	env.register_static_native_function("read_mmap", _ys_std_fs_read_mmap);
+	env.register_static_native_function("read_text", _ys_std_fs_read_text);
+	env.register_native<&_ys_std_fs_write_text>("write_text");
+	env.register_native<&_ys_std_fs_file_size>("file_size");
+	env.end_module_namespace();
+}
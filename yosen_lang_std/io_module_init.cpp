@@ -4,9 +4,13 @@ EXTERNC YOSENEXPORT void _ys_init_module()
 {
 	auto& env = YosenEnvironment::get();
 
+	_ys_std_io_init_output();
+
 	env.start_module_namespace("io");
-	env.register_static_native_function("print",	_ys_std_io_print);
-	env.register_static_native_function("println",	_ys_std_io_println);
-	env.register_static_native_function("input",	_ys_std_io_input);
+	env.register_static_native_function("print",		_ys_std_io_print);
+	env.register_static_native_function("println",		_ys_std_io_println);
+	env.register_static_native_function("input",		_ys_std_io_input);
+	env.register_static_native_function("flush",		_ys_std_io_flush);
+	env.register_static_native_function("write_all",	_ys_std_io_write_all);
 	env.end_module_namespace();
 }
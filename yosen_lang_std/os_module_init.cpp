@@ -5,13 +5,13 @@ EXTERNC YOSENEXPORT void _ys_init_module()
 	auto& env = YosenEnvironment::get();
 
 	env.start_module_namespace("os");
-	env.register_static_native_function("system",       _ys_std_os_system);
-	env.register_static_native_function("chdir",        _ys_std_os_chdir);
-	env.register_static_native_function("cwd",          _ys_std_os_cwd);
-	env.register_static_native_function("mkdir",        _ys_std_os_mkdir);
-	env.register_static_native_function("is_file",      _ys_std_os_is_file);
-	env.register_static_native_function("is_dir",       _ys_std_os_is_dir);
-	env.register_static_native_function("delete_file",  _ys_std_os_delete_file);
-	env.register_static_native_function("delete_dir",   _ys_std_os_delete_dir);
+	env.register_native<&_ys_std_os_system>("system");
+	env.register_native<&_ys_std_os_chdir>("chdir");
+	env.register_native<&_ys_std_os_cwd>("cwd");
+	env.register_native<&_ys_std_os_mkdir>("mkdir");
+	env.register_native<&_ys_std_os_is_file>("is_file");
+	env.register_native<&_ys_std_os_is_dir>("is_dir");
+	env.register_native<&_ys_std_os_delete_file>("delete_file");
+	env.register_native<&_ys_std_os_delete_dir>("delete_dir");
 	env.end_module_namespace();
 }
@@ -9,10 +9,10 @@ EXTERNC YOSENEXPORT void _ys_init_module()
 	auto& env = YosenEnvironment::get();
 
 	env.start_module_namespace("random");
-	env.register_static_native_function("gen_int",          _ys_std_random_gen_int);
-	env.register_static_native_function("gen_int_range",    _ys_std_random_gen_int_range);
-	env.register_static_native_function("gen_string",       _ys_std_random_gen_string);
-	env.register_static_native_function("gen_hex_string",   _ys_std_random_gen_hex_string);
-	env.register_static_native_function("gen_uuid",         _ys_std_random_gen_uuid);
+	env.register_native<&_ys_std_random_gen_int>("gen_int");
+	env.register_native<&_ys_std_random_gen_int_range>("gen_int_range");
+	env.register_native<&_ys_std_random_gen_string>("gen_string");
+	env.register_native<&_ys_std_random_gen_hex_string>("gen_hex_string");
+	env.register_native<&_ys_std_random_gen_uuid>("gen_uuid");
 	env.end_module_namespace();
 }
@@ -0,0 +1,11 @@
+#include "yosen_std_threading.h"
+
+EXTERNC YOSENEXPORT void _ys_init_module()
+{
+	auto& env = YosenEnvironment::get();
+
+	env.start_module_namespace("threading");
+	env.register_static_native_function("submit", _ys_std_threading_submit);
+	env.register_native<&_ys_std_threading_worker_count>("worker_count");
+	env.end_module_namespace();
+}
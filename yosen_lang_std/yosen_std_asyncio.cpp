@@ -0,0 +1,748 @@
+#include "yosen_std_asyncio.h"
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <string.h>
+#include <chrono>
+#include <queue>
+#include <deque>
+
+// Stacks are reserved lazily by the OS, so only the
+// pages touched by the interpreter use any memory.
+constexpr size_t AsyncTaskStackSize = 1024 * 1024;
+
+// Every stack is mapped with an inaccessible guard page below
+// it, so that a stack overflow faults instead of corrupting memory.
+static size_t get_guard_page_size()
+{
+	static const size_t s_page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+	return s_page_size;
+}
+
+static size_t get_task_stack_mapping_size()
+{
+	return get_guard_page_size() + AsyncTaskStackSize;
+}
+
+using async_clock = std::chrono::steady_clock;
+
+static void throw_async_exception(const std::string& reason)
+{
+	YosenEnvironment::get().throw_exception(RuntimeException(reason));
+}
+
+static void throw_async_errno_exception(const std::string& operation)
+{
+	throw_async_exception(operation + " failed: " + strerror(errno));
+}
+
+YosenAsyncTask::~YosenAsyncTask()
+{
+	if (stack)
+		munmap(stack, get_task_stack_mapping_size());
+
+	for (auto& arg : fn_args)
+		free_object(arg);
+
+	if (result)
+		free_object(result);
+}
+
+// Single threaded event loop that switches between the tasks
+// whenever they wait for timers or file descriptors.
+class YosenEventLoop
+{
+public:
+	YosenEventLoop();
+	~YosenEventLoop();
+
+	// Returns the event loop of the calling thread
+	static YosenEventLoop& get();
+
+	// Returns the task that is currently running, or nullptr if none
+	inline std::shared_ptr<YosenAsyncTask>& current_task() { return m_current_task; }
+
+	// Schedules a new task
+	void spawn(std::shared_ptr<YosenAsyncTask> task);
+
+	// Suspends the current task or runs the loop until the waiter is fired
+	void wait(std::shared_ptr<YosenAsyncWaiter> waiter);
+
+	// Creates a waiter for the task that is currently running
+	std::shared_ptr<YosenAsyncWaiter> make_waiter();
+
+	// Fires the waiter and schedules its task
+	void fire(std::shared_ptr<YosenAsyncWaiter>& waiter);
+
+	// Fires the waiter after the given number of milliseconds
+	void add_timer(int64_t ms, std::shared_ptr<YosenAsyncWaiter> waiter);
+
+	// Waits until the descriptor is readable or writable,
+	// returns false if it was closed while waiting.
+	bool wait_fd(int fd, bool writable);
+
+	// Wakes the tasks waiting for the descriptor and closes it
+	void close_fd(int fd);
+
+	// Runs the loop until all the tasks complete
+	void run();
+
+private:
+	int m_epoll_fd = -1;
+
+	std::shared_ptr<YosenAsyncTask> m_current_task;
+	ucontext_t m_loop_context;
+
+	std::deque<std::shared_ptr<YosenAsyncTask>> m_ready_tasks;
+	size_t m_live_task_count = 0;
+
+	struct Timer
+	{
+		async_clock::time_point deadline;
+		std::shared_ptr<YosenAsyncWaiter> waiter;
+
+		inline bool operator>(const Timer& other) const { return deadline > other.deadline; }
+	};
+
+	std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> m_timers;
+
+	// Reading and writing can be awaited at the same time by different tasks
+	struct FdWaiters
+	{
+		std::shared_ptr<YosenAsyncWaiter> read;
+		std::shared_ptr<YosenAsyncWaiter> write;
+	};
+
+	// Waiters registered in epoll for each descriptor
+	std::map<int, FdWaiters> m_fd_waiters;
+
+private:
+	// Processes tasks and events until the predicate is satisfied,
+	// returns false if there is nothing left that could satisfy it.
+	template <typename Pred>
+	bool run_until(Pred done);
+
+	// Switches to the task until it suspends or completes
+	void resume(std::shared_ptr<YosenAsyncTask> task);
+
+	// Waits for timers and descriptors and fires their waiters
+	void poll_events();
+
+	// Registers the events of the descriptor's pending waiters in epoll,
+	// returns false if the descriptor can't be polled.
+	bool update_fd_events(int fd, const FdWaiters& waiters);
+
+	static void task_entry();
+};
+
+YosenEventLoop::YosenEventLoop()
+{
+	m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+}
+
+YosenEventLoop::~YosenEventLoop()
+{
+	if (m_epoll_fd != -1)
+		close(m_epoll_fd);
+}
+
+YosenEventLoop& YosenEventLoop::get()
+{
+	static thread_local YosenEventLoop s_event_loop;
+	return s_event_loop;
+}
+
+void YosenEventLoop::spawn(std::shared_ptr<YosenAsyncTask> task)
+{
+	task->stack = mmap(nullptr, get_task_stack_mapping_size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	if (task->stack == MAP_FAILED)
+	{
+		task->stack = nullptr;
+		throw_async_errno_exception("Allocating task stack");
+		return;
+	}
+
+	// The stack grows down towards the guard page
+	if (mprotect(task->stack, get_guard_page_size(), PROT_NONE) == -1)
+	{
+		munmap(task->stack, get_task_stack_mapping_size());
+		task->stack = nullptr;
+		throw_async_errno_exception("Protecting task stack guard page");
+		return;
+	}
+
+	getcontext(&task->context);
+	task->context.uc_stack.ss_sp = static_cast<char*>(task->stack) + get_guard_page_size();
+	task->context.uc_stack.ss_size = AsyncTaskStackSize;
+	task->context.uc_link = &m_loop_context;
+	makecontext(&task->context, task_entry, 0);
+
+	++m_live_task_count;
+	m_ready_tasks.push_back(task);
+}
+
+void YosenEventLoop::task_entry()
+{
+	auto& loop = get();
+
+	// Raw pointer since this stack frame never gets unwound
+	auto task = loop.m_current_task.get();
+
+	auto& args = task->fn_args;
+	task->result = task->execution_context->call_function(task->fn_name, YosenArgs(args.data(), args.size()));
+	task->done = true;
+
+	// The task's exception is thrown on the thread running the loop
+	if (!task->result)
+	{
+		task->result = YosenObject_Null;
+		YosenEnvironment::get().throw_exception(*task->execution_context->get_last_exception());
+	}
+
+	for (auto& waiter : task->waiters)
+		loop.fire(waiter);
+
+	task->waiters.clear();
+
+	// Returning switches back to the loop through uc_link
+}
+
+void YosenEventLoop::resume(std::shared_ptr<YosenAsyncTask> task)
+{
+	// Each side of the switch keeps its own thread exception handler
+	auto exception_handler = YosenEnvironment::get_thread_exception_handler();
+
+	m_current_task = task;
+	swapcontext(&m_loop_context, &task->context);
+	m_current_task = nullptr;
+
+	YosenEnvironment::set_thread_exception_handler(exception_handler);
+
+	if (task->done)
+	{
+		--m_live_task_count;
+
+		// The task's stack and interpreter aren't needed anymore
+		munmap(task->stack, get_task_stack_mapping_size());
+		task->stack = nullptr;
+		task->execution_context.reset();
+	}
+}
+
+std::shared_ptr<YosenAsyncWaiter> YosenEventLoop::make_waiter()
+{
+	auto waiter = std::make_shared<YosenAsyncWaiter>();
+	waiter->task = m_current_task;
+
+	return waiter;
+}
+
+void YosenEventLoop::fire(std::shared_ptr<YosenAsyncWaiter>& waiter)
+{
+	if (waiter->fired)
+		return;
+
+	waiter->fired = true;
+
+	if (waiter->task)
+		m_ready_tasks.push_back(waiter->task);
+}
+
+void YosenEventLoop::wait(std::shared_ptr<YosenAsyncWaiter> waiter)
+{
+	if (waiter->fired)
+		return;
+
+	if (m_current_task)
+	{
+		// Suspend the task, the loop resumes it once the waiter fires
+		auto task = m_current_task;
+
+		auto exception_handler = YosenEnvironment::get_thread_exception_handler();
+		swapcontext(&task->context, &m_loop_context);
+		YosenEnvironment::set_thread_exception_handler(exception_handler);
+		return;
+	}
+
+	if (!run_until([&waiter]() { return waiter->fired; }))
+		throw_async_exception("Event loop has no tasks or events left to wait for");
+}
+
+void YosenEventLoop::add_timer(int64_t ms, std::shared_ptr<YosenAsyncWaiter> waiter)
+{
+	auto deadline = async_clock::now() + std::chrono::milliseconds(std::max<int64_t>(ms, 0));
+	m_timers.push({ deadline, waiter });
+}
+
+bool YosenEventLoop::wait_fd(int fd, bool writable)
+{
+	auto& waiters = m_fd_waiters[fd];
+	auto& waiter = writable ? waiters.write : waiters.read;
+
+	if (waiter)
+	{
+		throw_async_exception("Another task is already waiting for the descriptor");
+		return false;
+	}
+
+	waiter = make_waiter();
+	auto fd_waiter = waiter;
+
+	if (!update_fd_events(fd, waiters))
+	{
+		int error = errno;
+
+		waiter = nullptr;
+		if (!waiters.read && !waiters.write)
+			m_fd_waiters.erase(fd);
+
+		// Regular files are always ready and can't be polled
+		if (error == EPERM)
+			return true;
+
+		errno = error;
+		throw_async_errno_exception("Polling descriptor");
+		return false;
+	}
+
+	wait(fd_waiter);
+	return !fd_waiter->fd_closed;
+}
+
+void YosenEventLoop::close_fd(int fd)
+{
+	// Fails harmlessly if the descriptor was never polled
+	epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+
+	auto it = m_fd_waiters.find(fd);
+	if (it != m_fd_waiters.end())
+	{
+		auto waiters = std::move(it->second);
+		m_fd_waiters.erase(it);
+
+		for (auto waiter : { &waiters.read, &waiters.write })
+		{
+			if (*waiter)
+			{
+				(*waiter)->fd_closed = true;
+				fire(*waiter);
+			}
+		}
+	}
+
+	::close(fd);
+}
+
+bool YosenEventLoop::update_fd_events(int fd, const FdWaiters& waiters)
+{
+	epoll_event event = {};
+	event.events = EPOLLONESHOT;
+	event.data.fd = fd;
+
+	if (waiters.read)
+		event.events |= EPOLLIN;
+
+	if (waiters.write)
+		event.events |= EPOLLOUT;
+
+	if (epoll_ctl(m_epoll_fd, EPOLL_CTL_MOD, fd, &event) == -1)
+	{
+		if (errno != ENOENT || epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, fd, &event) == -1)
+			return false;
+	}
+
+	return true;
+}
+
+template <typename Pred>
+bool YosenEventLoop::run_until(Pred done)
+{
+	while (!done())
+	{
+		if (!m_ready_tasks.empty())
+		{
+			auto task = m_ready_tasks.front();
+			m_ready_tasks.pop_front();
+
+			resume(task);
+			continue;
+		}
+
+		// Nothing can happen anymore
+		if (m_timers.empty() && m_fd_waiters.empty())
+			return false;
+
+		poll_events();
+	}
+
+	return true;
+}
+
+void YosenEventLoop::poll_events()
+{
+	int timeout = -1;
+	if (!m_timers.empty())
+	{
+		auto remaining = std::chrono::ceil<std::chrono::milliseconds>(m_timers.top().deadline - async_clock::now());
+		timeout = static_cast<int>(std::max<int64_t>(remaining.count(), 0));
+	}
+
+	epoll_event events[64];
+	int event_count = epoll_wait(m_epoll_fd, events, 64, timeout);
+
+	for (int i = 0; i < event_count; ++i)
+	{
+		int fd = events[i].data.fd;
+
+		auto it = m_fd_waiters.find(fd);
+		if (it == m_fd_waiters.end())
+			continue;
+
+		auto& waiters = it->second;
+		std::shared_ptr<YosenAsyncWaiter> read_waiter, write_waiter;
+
+		// Errors and hang-ups wake both sides so that their next call reports them
+		if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+			read_waiter = std::move(waiters.read);
+
+		if (events[i].events & (EPOLLOUT | EPOLLHUP | EPOLLERR))
+			write_waiter = std::move(waiters.write);
+
+		// The one-shot registration is armed again for the side that is still waiting
+		if (waiters.read || waiters.write)
+			update_fd_events(fd, waiters);
+		else
+			m_fd_waiters.erase(it);
+
+		if (read_waiter)
+			fire(read_waiter);
+
+		if (write_waiter)
+			fire(write_waiter);
+	}
+
+	auto now = async_clock::now();
+	while (!m_timers.empty() && m_timers.top().deadline <= now)
+	{
+		auto waiter = m_timers.top().waiter;
+		m_timers.pop();
+
+		fire(waiter);
+	}
+}
+
+void YosenEventLoop::run()
+{
+	if (m_current_task)
+	{
+		throw_async_exception("asyncio::run() can't be called from inside of a task");
+		return;
+	}
+
+	if (!run_until([this]() { return m_live_task_count == 0; }))
+		throw_async_exception("Event loop has tasks waiting for events that never occur");
+}
+
+const ys_member_native_table_t YosenAsyncTaskObject::s_member_native_functions = {
+	{ "done",	done },
+	{ "result",	result },
+};
+
+YosenAsyncTaskObject::YosenAsyncTaskObject(std::shared_ptr<YosenAsyncTask> task)
+	: m_task(task)
+{
+	m_member_native_table = &s_member_native_functions;
+}
+
+YosenObject* YosenAsyncTaskObject::clone()
+{
+	return allocate_object<YosenAsyncTaskObject>(m_task);
+}
+
+std::string YosenAsyncTaskObject::to_string()
+{
+	return "Task " + instance_info();
+}
+
+const char* YosenAsyncTaskObject::runtime_name() const
+{
+	return "Task";
+}
+
+YosenObject* YosenAsyncTaskObject::done(YosenObject* self, YosenArgs args)
+{
+	auto& task = static_cast<YosenAsyncTaskObject*>(self)->m_task;
+	return get_boolean_object(task->done);
+}
+
+YosenObject* YosenAsyncTaskObject::result(YosenObject* self, YosenArgs args)
+{
+	auto& task = static_cast<YosenAsyncTaskObject*>(self)->m_task;
+	if (!task->done)
+		return YosenObject_Null;
+
+	return task->result->clone();
+}
+
+YosenObject* _ys_std_asyncio_spawn(YosenArgs args)
+{
+	std::string fn_name;
+	if (!arg_parse(args, fn_name))
+		return nullptr;
+
+	auto task = std::make_shared<YosenAsyncTask>();
+	task->fn_name = fn_name;
+
+	// Every task gets its own interpreter state
+	task->execution_context = YosenEnvironment::get().create_execution_context();
+	if (!task->execution_context)
+	{
+		throw_async_exception("No interpreter is available to run \"" + fn_name + "\"");
+		return nullptr;
+	}
+
+	for (size_t i = 1; i < args.size(); ++i)
+		task->fn_args.push_back(args[i]->clone());
+
+	YosenEventLoop::get().spawn(task);
+	return allocate_object<YosenAsyncTaskObject>(task);
+}
+
+YosenObject* _ys_std_asyncio_await(YosenArgs args)
+{
+	YosenObject* task_arg = nullptr;
+	if (!arg_parse(args, task_arg))
+		return nullptr;
+
+	auto task_object = dynamic_cast<YosenAsyncTaskObject*>(task_arg);
+	if (!task_object)
+	{
+		throw_async_exception("asyncio::await() expected a task, received " + std::string(task_arg->runtime_name()));
+		return nullptr;
+	}
+
+	auto& loop = YosenEventLoop::get();
+	auto task = task_object->get_task();
+
+	if (task == loop.current_task())
+	{
+		throw_async_exception("A task can't await itself");
+		return nullptr;
+	}
+
+	if (!task->done)
+	{
+		auto waiter = loop.make_waiter();
+		task->waiters.push_back(waiter);
+
+		loop.wait(waiter);
+	}
+
+	return task->result ? task->result->clone() : YosenObject_Null;
+}
+
+void _ys_std_asyncio_run()
+{
+	YosenEventLoop::get().run();
+}
+
+void _ys_std_asyncio_sleep(int64_t ms)
+{
+	auto& loop = YosenEventLoop::get();
+
+	auto waiter = loop.make_waiter();
+	loop.add_timer(ms, waiter);
+	loop.wait(waiter);
+}
+
+// Descriptors created by the module never block the loop
+static void set_non_blocking(int fd)
+{
+	fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+YosenObject* _ys_std_asyncio_pipe()
+{
+	int fds[2];
+	if (::pipe(fds) == -1)
+	{
+		throw_async_errno_exception("Creating pipe");
+		return nullptr;
+	}
+
+	set_non_blocking(fds[0]);
+	set_non_blocking(fds[1]);
+
+	return allocate_object<YosenList>(std::vector<YosenObject*>{
+		allocate_object<YosenInteger>(fds[0]),
+		allocate_object<YosenInteger>(fds[1])
+	});
+}
+
+std::string _ys_std_asyncio_read(int64_t fd, int64_t max_bytes)
+{
+	auto& loop = YosenEventLoop::get();
+	std::string buffer(static_cast<size_t>(std::max<int64_t>(max_bytes, 0)), '\0');
+
+	while (true)
+	{
+		auto bytes_read = ::read(static_cast<int>(fd), buffer.data(), buffer.size());
+		if (bytes_read >= 0)
+		{
+			buffer.resize(static_cast<size_t>(bytes_read));
+			return buffer;
+		}
+
+		if (errno != EAGAIN && errno != EWOULDBLOCK)
+		{
+			throw_async_errno_exception("Reading");
+			return "";
+		}
+
+		// Reads from a descriptor closed while waiting end like at the end of file
+		if (!loop.wait_fd(static_cast<int>(fd), false))
+			return "";
+	}
+}
+
+int64_t _ys_std_asyncio_write(int64_t fd, std::string_view data)
+{
+	auto& loop = YosenEventLoop::get();
+	size_t bytes_written = 0;
+
+	while (bytes_written < data.size())
+	{
+		auto result = ::write(static_cast<int>(fd), data.data() + bytes_written, data.size() - bytes_written);
+		if (result >= 0)
+		{
+			bytes_written += static_cast<size_t>(result);
+			continue;
+		}
+
+		if (errno != EAGAIN && errno != EWOULDBLOCK)
+		{
+			throw_async_errno_exception("Writing");
+			break;
+		}
+
+		if (!loop.wait_fd(static_cast<int>(fd), true))
+		{
+			throw_async_exception("Writing failed: descriptor was closed");
+			break;
+		}
+	}
+
+	return static_cast<int64_t>(bytes_written);
+}
+
+void _ys_std_asyncio_close(int64_t fd)
+{
+	YosenEventLoop::get().close_fd(static_cast<int>(fd));
+}
+
+int64_t _ys_std_asyncio_listen(int64_t port)
+{
+	int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (fd == -1)
+	{
+		throw_async_errno_exception("Creating socket");
+		return -1;
+	}
+
+	int reuse = 1;
+	setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+	sockaddr_in address = {};
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_ANY);
+	address.sin_port = htons(static_cast<uint16_t>(port));
+
+	if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1 || ::listen(fd, SOMAXCONN) == -1)
+	{
+		throw_async_errno_exception("Listening on port " + std::to_string(port));
+		::close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+int64_t _ys_std_asyncio_accept(int64_t fd)
+{
+	auto& loop = YosenEventLoop::get();
+
+	while (true)
+	{
+		int connection_fd = accept4(static_cast<int>(fd), nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if (connection_fd != -1)
+			return connection_fd;
+
+		if (errno != EAGAIN && errno != EWOULDBLOCK)
+		{
+			throw_async_errno_exception("Accepting connection");
+			return -1;
+		}
+
+		if (!loop.wait_fd(static_cast<int>(fd), false))
+		{
+			throw_async_exception("Accepting connection failed: descriptor was closed");
+			return -1;
+		}
+	}
+}
+
+int64_t _ys_std_asyncio_connect(const char* address, int64_t port)
+{
+	sockaddr_in socket_address = {};
+	socket_address.sin_family = AF_INET;
+	socket_address.sin_port = htons(static_cast<uint16_t>(port));
+
+	if (inet_pton(AF_INET, address, &socket_address.sin_addr) != 1)
+	{
+		throw_async_exception("Invalid IPv4 address \"" + std::string(address) + "\"");
+		return -1;
+	}
+
+	int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (fd == -1)
+	{
+		throw_async_errno_exception("Creating socket");
+		return -1;
+	}
+
+	if (::connect(fd, reinterpret_cast<sockaddr*>(&socket_address), sizeof(socket_address)) == -1)
+	{
+		if (errno != EINPROGRESS)
+		{
+			throw_async_errno_exception("Connecting");
+			::close(fd);
+			return -1;
+		}
+
+		// The connection completes once the socket becomes writable
+		if (!YosenEventLoop::get().wait_fd(fd, true))
+		{
+			throw_async_exception("Connecting failed: descriptor was closed");
+			return -1;
+		}
+
+		int error = 0;
+		socklen_t error_size = sizeof(error);
+		getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &error_size);
+
+		if (error)
+		{
+			errno = error;
+			throw_async_errno_exception("Connecting");
+			::close(fd);
+			return -1;
+		}
+	}
+
+	return fd;
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <YosenEnvironment.h>
+#include <ucontext.h>
+using namespace yosen;
+
+// Coroutine running a single function on its own stack.
+// The stack and interpreter state live on the heap, so the
+// task can be suspended inside of any native function call.
+struct YosenAsyncTask
+{
+	ucontext_t context;
+
+	// Start of the stack mapping, including the guard page
+	void* stack = nullptr;
+
+	std::string fn_name;
+	std::vector<YosenObject*> fn_args;
+	std::unique_ptr<YosenExecutionContext> execution_context;
+
+	// Object returned by the function, owned by the task
+	YosenObject* result = nullptr;
+	bool done = false;
+
+	// Wait handles of the tasks awaiting this task's completion
+	std::vector<std::shared_ptr<struct YosenAsyncWaiter>> waiters;
+
+	~YosenAsyncTask();
+};
+
+// Something waiting for an event, either a suspended task
+// or the loop's caller that isn't running inside of a task.
+struct YosenAsyncWaiter
+{
+	std::shared_ptr<YosenAsyncTask> task;
+	bool fired = false;
+
+	// Set if the awaited descriptor was closed before it became ready
+	bool fd_closed = false;
+};
+
+// Handle to a task given to the scripts
+class YosenAsyncTaskObject : public YosenObject
+{
+public:
+	YosenAsyncTaskObject(std::shared_ptr<YosenAsyncTask> task);
+
+	YosenObject* clone() override;
+	std::string to_string() override;
+	const char* runtime_name() const override;
+
+	inline std::shared_ptr<YosenAsyncTask>& get_task() { return m_task; }
+
+private:
+	std::shared_ptr<YosenAsyncTask> m_task;
+
+	// Returns whether or not the task has completed
+	static YosenObject* done(YosenObject* self, YosenArgs args);
+
+	// Returns a copy of the task's result, or null if it's still running
+	static YosenObject* result(YosenObject* self, YosenArgs args);
+
+	static const ys_member_native_table_t s_member_native_functions;
+};
+
+// Creates a task that calls the function with copies of the
+// given arguments once the event loop runs, returns the task.
+// Example: var task = asyncio::spawn("fetch", url);
+YosenObject* _ys_std_asyncio_spawn(YosenArgs args);
+
+// Waits for the task to complete and returns a copy of its result.
+// Suspends the current task, or runs the event loop if called outside of one.
+YosenObject* _ys_std_asyncio_await(YosenArgs args);
+
+// Runs the event loop until all the tasks complete
+void _ys_std_asyncio_run();
+
+// Waits for the given number of milliseconds
+void _ys_std_asyncio_sleep(int64_t ms);
+
+// Creates a pipe and returns a list of its read and write descriptors
+YosenObject* _ys_std_asyncio_pipe();
+
+// Waits for the descriptor to become readable and reads up to
+// the given number of bytes, returns an empty string at the end of file.
+std::string _ys_std_asyncio_read(int64_t fd, int64_t max_bytes);
+
+// Writes the entire string, waiting whenever the descriptor
+// isn't writable, and returns the number of bytes written.
+int64_t _ys_std_asyncio_write(int64_t fd, std::string_view data);
+
+// Closes the descriptor
+void _ys_std_asyncio_close(int64_t fd);
+
+// Creates a TCP socket listening on all interfaces and returns its descriptor
+int64_t _ys_std_asyncio_listen(int64_t port);
+
+// Waits for an incoming connection and returns its descriptor
+int64_t _ys_std_asyncio_accept(int64_t fd);
+
+// Connects to an IPv4 address and returns the connection's descriptor
+int64_t _ys_std_asyncio_connect(const char* address, int64_t port);
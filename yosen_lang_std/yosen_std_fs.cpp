@@ -0,0 +1,735 @@
+#include "yosen_std_fs.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <Windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+static void throw_fs_exception(const std::string& reason)
+{
+	YosenEnvironment::get().throw_exception(RuntimeException(reason));
+}
+
+//
+// Bytes
+//
+const ys_member_native_table_t YosenBytes::s_member_native_functions = {
+	{ "length", length },
+	{ "get", get },
+	{ "to_str", to_str },
+};
+
+YosenBytes::YosenBytes()
+{
+	m_member_native_table = &s_member_native_functions;
+}
+
+YosenBytes::YosenBytes(std::vector<uint8_t>&& data)
+	: data(std::move(data))
+{
+	m_member_native_table = &s_member_native_functions;
+}
+
+YosenObject* YosenBytes::clone()
+{
+	return allocate_object<YosenBytes>(std::vector<uint8_t>(data));
+}
+
+std::string YosenBytes::to_string()
+{
+	return "Bytes(" + std::to_string(data.size()) + ") " + instance_info();
+}
+
+const char* YosenBytes::runtime_name() const
+{
+	return "Bytes";
+}
+
+YosenObject* YosenBytes::length(YosenObject* self, YosenArgs args)
+{
+	auto this_obj = static_cast<YosenBytes*>(self);
+	return allocate_object<YosenInteger>(static_cast<int64_t>(this_obj->data.size()));
+}
+
+YosenObject* YosenBytes::get(YosenObject* self, YosenArgs args)
+{
+	int64_t idx;
+	if (!arg_parse(args, idx))
+		return nullptr;
+
+	auto this_obj = static_cast<YosenBytes*>(self);
+	if (idx < 0 || idx >= static_cast<int64_t>(this_obj->data.size()))
+	{
+		throw_fs_exception("Bytes::get() - index out of range");
+		return nullptr;
+	}
+
+	return allocate_object<YosenInteger>(static_cast<int64_t>(this_obj->data[idx]));
+}
+
+YosenObject* YosenBytes::to_str(YosenObject* self, YosenArgs args)
+{
+	auto this_obj = static_cast<YosenBytes*>(self);
+	return allocate_object<YosenString>(std::string(this_obj->data.begin(), this_obj->data.end()));
+}
+
+//
+// FileReader
+//
+bool YosenFileReaderState::read_line(std::string& line)
+{
+	size_t scan_from = begin;
+
+	while (true)
+	{
+		auto newline = static_cast<char*>(memchr(buffer.data() + scan_from, '\n', end - scan_from));
+		if (newline)
+		{
+			size_t line_end = newline - buffer.data();
+			size_t next_line = line_end + 1;
+
+			if (line_end > begin && buffer[line_end - 1] == '\r')
+				--line_end;
+
+			line.assign(buffer.data() + begin, line_end - begin);
+			begin = next_line;
+			return true;
+		}
+
+		// Only the newly read data has to be scanned after refilling
+		size_t scanned = end - begin;
+
+		if (!fill())
+		{
+			// Last line without a trailing newline
+			if (begin == end)
+				return false;
+
+			line.assign(buffer.data() + begin, end - begin);
+			begin = end;
+			return true;
+		}
+
+		scan_from = begin + scanned;
+	}
+}
+
+size_t YosenFileReaderState::read_chunk(std::vector<uint8_t>& out, size_t size)
+{
+	out.clear();
+	out.reserve(size);
+
+	while (out.size() < size)
+	{
+		if (begin == end && !fill())
+			break;
+
+		size_t count = std::min(size - out.size(), end - begin);
+		out.insert(out.end(), buffer.data() + begin, buffer.data() + begin + count);
+		begin += count;
+	}
+
+	return out.size();
+}
+
+bool YosenFileReaderState::at_eof()
+{
+	return begin == end && !fill();
+}
+
+size_t YosenFileReaderState::fill()
+{
+	if (!file)
+		return 0;
+
+	if (begin > 0)
+	{
+		memmove(buffer.data(), buffer.data() + begin, end - begin);
+		end -= begin;
+		begin = 0;
+	}
+
+	if (end == buffer.size())
+		buffer.resize(buffer.size() * 2);
+
+	auto bytes_read = fread(buffer.data() + end, 1, buffer.size() - end, file);
+	end += bytes_read;
+
+	return bytes_read;
+}
+
+void YosenFileReaderState::close()
+{
+	if (file)
+		fclose(file);
+
+	file = nullptr;
+	begin = end = 0;
+}
+
+YosenFileReaderState::~YosenFileReaderState()
+{
+	close();
+}
+
+static std::shared_ptr<YosenFileReaderState> open_reader_state(const std::string& path)
+{
+	auto file = fopen(path.c_str(), "rb");
+	if (!file)
+	{
+		throw_fs_exception("Failed to open file \"" + path + "\" for reading");
+		return nullptr;
+	}
+
+	// Reads already go through the state's own block buffer
+	setvbuf(file, nullptr, _IONBF, 0);
+
+	auto state = std::make_shared<YosenFileReaderState>();
+	state->file = file;
+
+	return state;
+}
+
+const ys_member_native_table_t YosenFileReader::s_member_native_functions = {
+	{ "read_line", read_line },
+	{ "read_chunk", read_chunk },
+	{ "eof", eof },
+	{ "close", close },
+};
+
+YosenFileReader::YosenFileReader(std::shared_ptr<YosenFileReaderState> state)
+	: m_state(state)
+{
+	m_member_native_table = &s_member_native_functions;
+}
+
+YosenObject* YosenFileReader::clone()
+{
+	return allocate_object<YosenFileReader>(m_state);
+}
+
+std::string YosenFileReader::to_string()
+{
+	return "FileReader " + instance_info();
+}
+
+const char* YosenFileReader::runtime_name() const
+{
+	return "FileReader";
+}
+
+YosenObject* YosenFileReader::read_line(YosenObject* self, YosenArgs args)
+{
+	auto& state = static_cast<YosenFileReader*>(self)->m_state;
+
+	std::string line;
+	if (!state->read_line(line))
+		return YosenObject_Null;
+
+	return allocate_object<YosenString>(line);
+}
+
+YosenObject* YosenFileReader::read_chunk(YosenObject* self, YosenArgs args)
+{
+	int64_t size;
+	if (!arg_parse(args, size))
+		return nullptr;
+
+	if (size <= 0)
+	{
+		throw_fs_exception("FileReader::read_chunk() - chunk size has to be positive");
+		return nullptr;
+	}
+
+	auto& state = static_cast<YosenFileReader*>(self)->m_state;
+
+	std::vector<uint8_t> data;
+	if (!state->read_chunk(data, static_cast<size_t>(size)))
+		return YosenObject_Null;
+
+	return allocate_object<YosenBytes>(std::move(data));
+}
+
+YosenObject* YosenFileReader::eof(YosenObject* self, YosenArgs args)
+{
+	auto& state = static_cast<YosenFileReader*>(self)->m_state;
+	return get_boolean_object(state->at_eof());
+}
+
+YosenObject* YosenFileReader::close(YosenObject* self, YosenArgs args)
+{
+	auto& state = static_cast<YosenFileReader*>(self)->m_state;
+	state->close();
+
+	return YosenObject_Null;
+}
+
+//
+// FileWriter
+//
+void YosenFileWriterState::close()
+{
+	if (file)
+		fclose(file);
+
+	file = nullptr;
+}
+
+YosenFileWriterState::~YosenFileWriterState()
+{
+	close();
+}
+
+const ys_member_native_table_t YosenFileWriter::s_member_native_functions = {
+	{ "write", write },
+	{ "write_line", write_line },
+	{ "flush", flush },
+	{ "close", close },
+};
+
+YosenFileWriter::YosenFileWriter(std::shared_ptr<YosenFileWriterState> state)
+	: m_state(state)
+{
+	m_member_native_table = &s_member_native_functions;
+}
+
+YosenObject* YosenFileWriter::clone()
+{
+	return allocate_object<YosenFileWriter>(m_state);
+}
+
+std::string YosenFileWriter::to_string()
+{
+	return "FileWriter " + instance_info();
+}
+
+const char* YosenFileWriter::runtime_name() const
+{
+	return "FileWriter";
+}
+
+// Writes the object to the file without any intermediate copies for strings, views and bytes
+static bool write_object(YosenFileWriterState& state, YosenObject* obj, bool newline)
+{
+	if (!state.file)
+	{
+		throw_fs_exception("FileWriter - the file is closed");
+		return false;
+	}
+
+	std::string_view contents;
+
+	if (get_string_contents(obj, contents))
+		fwrite(contents.data(), 1, contents.size(), state.file);
+	else if (auto bytes = dynamic_cast<YosenBytes*>(obj))
+		fwrite(bytes->data.data(), 1, bytes->data.size(), state.file);
+	else
+	{
+		auto value = obj->to_string();
+		fwrite(value.data(), 1, value.size(), state.file);
+	}
+
+	if (newline)
+		fputc('\n', state.file);
+
+	return true;
+}
+
+YosenObject* YosenFileWriter::write(YosenObject* self, YosenArgs args)
+{
+	YosenObject* obj;
+	if (!arg_parse(args, obj))
+		return nullptr;
+
+	auto& state = static_cast<YosenFileWriter*>(self)->m_state;
+	return write_object(*state, obj, false) ? YosenObject_Null : nullptr;
+}
+
+YosenObject* YosenFileWriter::write_line(YosenObject* self, YosenArgs args)
+{
+	YosenObject* obj;
+	if (!arg_parse(args, obj))
+		return nullptr;
+
+	auto& state = static_cast<YosenFileWriter*>(self)->m_state;
+	return write_object(*state, obj, true) ? YosenObject_Null : nullptr;
+}
+
+YosenObject* YosenFileWriter::flush(YosenObject* self, YosenArgs args)
+{
+	auto& state = static_cast<YosenFileWriter*>(self)->m_state;
+	if (state->file)
+		fflush(state->file);
+
+	return YosenObject_Null;
+}
+
+YosenObject* YosenFileWriter::close(YosenObject* self, YosenArgs args)
+{
+	auto& state = static_cast<YosenFileWriter*>(self)->m_state;
+	state->close();
+
+	return YosenObject_Null;
+}
+
+//
+// MappedFile
+//
+#ifdef _WIN32
+bool YosenMappedFileData::map(const char* path)
+{
+	file_handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file_handle == INVALID_HANDLE_VALUE)
+	{
+		file_handle = nullptr;
+		return false;
+	}
+
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(file_handle, &file_size))
+		return false;
+
+	size = static_cast<size_t>(file_size.QuadPart);
+
+	// Empty files can't be mapped
+	if (!size)
+		return true;
+
+	mapping_handle = CreateFileMappingA(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping_handle)
+		return false;
+
+	data = static_cast<const char*>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+	return data != nullptr;
+}
+
+YosenMappedFileData::~YosenMappedFileData()
+{
+	if (data)
+		UnmapViewOfFile(data);
+
+	if (mapping_handle)
+		CloseHandle(mapping_handle);
+
+	if (file_handle)
+		CloseHandle(file_handle);
+}
+#else
+bool YosenMappedFileData::map(const char* path)
+{
+	int fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) != 0)
+	{
+		::close(fd);
+		return false;
+	}
+
+	size = static_cast<size_t>(file_stat.st_size);
+
+	// Empty files can't be mapped
+	if (!size)
+	{
+		::close(fd);
+		return true;
+	}
+
+	// The mapping stays valid after the descriptor is closed
+	auto address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+
+	if (address == MAP_FAILED)
+	{
+		size = 0;
+		return false;
+	}
+
+	madvise(address, size, MADV_SEQUENTIAL);
+
+	data = static_cast<const char*>(address);
+	return true;
+}
+
+YosenMappedFileData::~YosenMappedFileData()
+{
+	if (data)
+		munmap(const_cast<char*>(data), size);
+}
+#endif
+
+const ys_member_native_table_t YosenMappedFile::s_member_native_functions = {
+	{ "length", length },
+	{ "get", get },
+	{ "substr", substr },
+	{ "find", find },
+	{ "count_lines", count_lines },
+	{ "to_str", to_str },
+	{ "view", view },
+};
+
+YosenMappedFile::YosenMappedFile(std::shared_ptr<YosenMappedFileData> mapping)
+	: m_mapping(mapping)
+{
+	m_member_native_table = &s_member_native_functions;
+}
+
+YosenObject* YosenMappedFile::clone()
+{
+	return allocate_object<YosenMappedFile>(m_mapping);
+}
+
+std::string YosenMappedFile::to_string()
+{
+	return "MappedFile(" + std::to_string(m_mapping->size) + ") " + instance_info();
+}
+
+const char* YosenMappedFile::runtime_name() const
+{
+	return "MappedFile";
+}
+
+YosenObject* YosenMappedFile::length(YosenObject* self, YosenArgs args)
+{
+	auto& mapping = static_cast<YosenMappedFile*>(self)->m_mapping;
+	return allocate_object<YosenInteger>(static_cast<int64_t>(mapping->size));
+}
+
+YosenObject* YosenMappedFile::get(YosenObject* self, YosenArgs args)
+{
+	int64_t idx;
+	if (!arg_parse(args, idx))
+		return nullptr;
+
+	auto& mapping = static_cast<YosenMappedFile*>(self)->m_mapping;
+	if (idx < 0 || idx >= static_cast<int64_t>(mapping->size))
+	{
+		throw_fs_exception("MappedFile::get() - index out of range");
+		return nullptr;
+	}
+
+	return allocate_object<YosenInteger>(static_cast<int64_t>(static_cast<uint8_t>(mapping->data[idx])));
+}
+
+YosenObject* YosenMappedFile::substr(YosenObject* self, YosenArgs args)
+{
+	int64_t start, count;
+	if (!arg_parse(args, start, count))
+		return nullptr;
+
+	auto& mapping = static_cast<YosenMappedFile*>(self)->m_mapping;
+	if (start < 0 || start > static_cast<int64_t>(mapping->size) || count < 0)
+	{
+		throw_fs_exception("MappedFile::substr() - range out of bounds");
+		return nullptr;
+	}
+
+	auto available = mapping->size - static_cast<size_t>(start);
+	auto length = std::min(static_cast<size_t>(count), available);
+
+	return allocate_object<YosenString>(std::string(mapping->data + start, length));
+}
+
+YosenObject* YosenMappedFile::find(YosenObject* self, YosenArgs args)
+{
+	std::string_view needle;
+	if (!arg_parse(args, needle))
+		return nullptr;
+
+	int64_t start = 0;
+	if (args.size() > 1 && !arg_parse(args, needle, start))
+		return nullptr;
+
+	auto& mapping = static_cast<YosenMappedFile*>(self)->m_mapping;
+	if (start < 0)
+		start = 0;
+
+	auto contents = std::string_view(mapping->data, mapping->size);
+	auto idx = string_kernels::find(contents, needle, static_cast<size_t>(start));
+
+	return allocate_object<YosenInteger>(idx == std::string_view::npos ? int64_t(-1) : static_cast<int64_t>(idx));
+}
+
+YosenObject* YosenMappedFile::count_lines(YosenObject* self, YosenArgs args)
+{
+	auto& mapping = static_cast<YosenMappedFile*>(self)->m_mapping;
+	auto contents = std::string_view(mapping->data, mapping->size);
+
+	// A last line without a trailing newline still counts
+	auto lines = string_kernels::count_byte(contents, '\n');
+	if (!contents.empty() && contents.back() != '\n')
+		++lines;
+
+	return allocate_object<YosenInteger>(static_cast<int64_t>(lines));
+}
+
+YosenObject* YosenMappedFile::to_str(YosenObject* self, YosenArgs args)
+{
+	auto& mapping = static_cast<YosenMappedFile*>(self)->m_mapping;
+	return allocate_object<YosenString>(std::string(mapping->data, mapping->size));
+}
+
+YosenObject* YosenMappedFile::view(YosenObject* self, YosenArgs args)
+{
+	auto& mapping = static_cast<YosenMappedFile*>(self)->m_mapping;
+	return allocate_object<YosenStringView>(mapping, std::string_view(mapping->data, mapping->size));
+}
+
+//
+// Module functions
+//
+YosenObject* _ys_std_fs_open_reader(YosenArgs args)
+{
+	std::string path;
+	if (!arg_parse(args, path))
+		return nullptr;
+
+	auto state = open_reader_state(path);
+	if (!state)
+		return nullptr;
+
+	return allocate_object<YosenFileReader>(state);
+}
+
+YosenObject* _ys_std_fs_open_writer(YosenArgs args)
+{
+	std::string path;
+	if (!arg_parse(args, path))
+		return nullptr;
+
+	bool append = false;
+	if (args.size() > 1 && !arg_parse(args, path, append))
+		return nullptr;
+
+	auto file = fopen(path.c_str(), append ? "ab" : "wb");
+	if (!file)
+	{
+		throw_fs_exception("Failed to open file \"" + path + "\" for writing");
+		return nullptr;
+	}
+
+	setvbuf(file, nullptr, _IOFBF, YOSEN_FS_BLOCK_SIZE);
+
+	auto state = std::make_shared<YosenFileWriterState>();
+	state->file = file;
+
+	return allocate_object<YosenFileWriter>(state);
+}
+
+YosenObject* _ys_std_fs_for_each_line(YosenArgs args)
+{
+	std::string path, fn_name;
+	if (!arg_parse(args, path, fn_name))
+		return nullptr;
+
+	auto context = YosenEnvironment::get().create_execution_context();
+	if (!context)
+	{
+		throw_fs_exception("No interpreter is available to run \"" + fn_name + "\"");
+		return nullptr;
+	}
+
+	auto state = open_reader_state(path);
+	if (!state)
+		return nullptr;
+
+	// The same string object is passed for every line since calls copy their arguments
+	auto line = allocate_object<YosenString>();
+	YosenObject* fn_args[] = { line };
+
+	int64_t line_count = 0;
+
+	while (state->read_line(line->value))
+	{
+		++line_count;
+
+		auto result = context->call_function(fn_name, YosenArgs(fn_args, 1));
+		if (!result)
+		{
+			free_object(line);
+
+			YosenEnvironment::get().throw_exception(*context->get_last_exception());
+			return nullptr;
+		}
+
+		bool stop = result->is<YosenBoolean>() && !result->as<YosenBoolean>()->value;
+		free_object(result);
+
+		if (stop)
+			break;
+	}
+
+	free_object(line);
+	return allocate_object<YosenInteger>(line_count);
+}
+
+YosenObject* _ys_std_fs_read_mmap(YosenArgs args)
+{
+	std::string path;
+	if (!arg_parse(args, path))
+		return nullptr;
+
+	auto mapping = std::make_shared<YosenMappedFileData>();
+	if (!mapping->map(path.c_str()))
+	{
+		throw_fs_exception("Failed to map file \"" + path + "\"");
+		return nullptr;
+	}
+
+	return allocate_object<YosenMappedFile>(mapping);
+}
+
+YosenObject* _ys_std_fs_read_text(YosenArgs args)
+{
+	std::string path;
+	if (!arg_parse(args, path))
+		return nullptr;
+
+	auto state = open_reader_state(path);
+	if (!state)
+		return nullptr;
+
+	std::error_code ec;
+	auto size = std::filesystem::file_size(path, ec);
+
+	std::string contents;
+	if (!ec)
+		contents.reserve(size);
+
+	while (state->begin < state->end || !state->at_eof())
+	{
+		contents.append(state->buffer.data() + state->begin, state->end - state->begin);
+		state->begin = state->end;
+	}
+
+	return allocate_object<YosenString>(contents);
+}
+
+bool _ys_std_fs_write_text(const char* path, std::string_view text)
+{
+	auto file = fopen(path, "wb");
+	if (!file)
+		return false;
+
+	bool result = fwrite(text.data(), 1, text.size(), file) == text.size();
+	return (fclose(file) == 0) && result;
+}
+
+int64_t _ys_std_fs_file_size(const char* path)
+{
+	std::error_code ec;
+	auto size = std::filesystem::file_size(path, ec);
+
+	return ec ? -1 : static_cast<int64_t>(size);
+}
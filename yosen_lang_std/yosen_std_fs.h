@@ -0,0 +1,198 @@
+#pragma once
+#include <YosenEnvironment.h>
+#include <cstdio>
+using namespace yosen;
+
+// Block size used for buffered file reads and writes
+constexpr size_t YOSEN_FS_BLOCK_SIZE = 64 * 1024;
+
+// Growable buffer of raw bytes returned by chunked reads
+class YosenBytes : public YosenObject
+{
+public:
+	YosenBytes();
+	YosenBytes(std::vector<uint8_t>&& data);
+
+	YosenObject* clone() override;
+	std::string to_string() override;
+	const char* runtime_name() const override;
+
+	std::vector<uint8_t> data;
+
+private:
+	static YosenObject* length(YosenObject* self, YosenArgs args);
+	static YosenObject* get(YosenObject* self, YosenArgs args);
+	static YosenObject* to_str(YosenObject* self, YosenArgs args);
+
+	static const ys_member_native_table_t s_member_native_functions;
+};
+
+// Open file read in large blocks, lines are split
+// directly out of the block without per-line syscalls.
+struct YosenFileReaderState
+{
+	FILE* file = nullptr;
+
+	std::vector<char> buffer = std::vector<char>(YOSEN_FS_BLOCK_SIZE);
+	size_t begin = 0;
+	size_t end = 0;
+
+	// Reads the next line without its line terminator,
+	// returns false if the end of the file was reached.
+	bool read_line(std::string& line);
+
+	// Reads up to the given number of bytes
+	size_t read_chunk(std::vector<uint8_t>& out, size_t size);
+
+	// Returns whether or not there's any data left to read
+	bool at_eof();
+
+	void close();
+
+	~YosenFileReaderState();
+
+private:
+	// Moves the unread data to the front of the buffer and reads the next block,
+	// the buffer is grown if a single line doesn't fit in it. Returns the number of bytes read.
+	size_t fill();
+};
+
+// Handle to a file opened for reading, copies of the handle share the file
+class YosenFileReader : public YosenObject
+{
+public:
+	YosenFileReader(std::shared_ptr<YosenFileReaderState> state);
+
+	YosenObject* clone() override;
+	std::string to_string() override;
+	const char* runtime_name() const override;
+
+private:
+	std::shared_ptr<YosenFileReaderState> m_state;
+
+	// Returns the next line as a string or null at the end of the file
+	static YosenObject* read_line(YosenObject* self, YosenArgs args);
+
+	// Returns up to the given number of bytes or null at the end of the file
+	static YosenObject* read_chunk(YosenObject* self, YosenArgs args);
+
+	// Returns whether or not the whole file has been read
+	static YosenObject* eof(YosenObject* self, YosenArgs args);
+
+	static YosenObject* close(YosenObject* self, YosenArgs args);
+
+	static const ys_member_native_table_t s_member_native_functions;
+};
+
+// File opened for writing, stdio buffers the writes in large blocks
+struct YosenFileWriterState
+{
+	FILE* file = nullptr;
+
+	void close();
+
+	~YosenFileWriterState();
+};
+
+// Handle to a file opened for writing, copies of the handle share the file
+class YosenFileWriter : public YosenObject
+{
+public:
+	YosenFileWriter(std::shared_ptr<YosenFileWriterState> state);
+
+	YosenObject* clone() override;
+	std::string to_string() override;
+	const char* runtime_name() const override;
+
+private:
+	std::shared_ptr<YosenFileWriterState> m_state;
+
+	// Writes the string representation of the object, bytes are written as is
+	static YosenObject* write(YosenObject* self, YosenArgs args);
+
+	// Writes the string representation of the object followed by a newline
+	static YosenObject* write_line(YosenObject* self, YosenArgs args);
+
+	static YosenObject* flush(YosenObject* self, YosenArgs args);
+	static YosenObject* close(YosenObject* self, YosenArgs args);
+
+	static const ys_member_native_table_t s_member_native_functions;
+};
+
+// Read-only memory mapping of a whole file, unmapped when destroyed
+struct YosenMappedFileData
+{
+	const char* data = nullptr;
+	size_t size = 0;
+
+#ifdef _WIN32
+	void* file_handle = nullptr;
+	void* mapping_handle = nullptr;
+#endif
+
+	// Maps the file at the given path, returns false on failure
+	bool map(const char* path);
+
+	~YosenMappedFileData();
+};
+
+// Read-only view of a memory mapped file. Reading the contents doesn't copy
+// the file, only the strings returned by substr() and to_str() are allocated.
+// view() returns a StringView over the mapping that keeps it mapped.
+class YosenMappedFile : public YosenObject
+{
+public:
+	YosenMappedFile(std::shared_ptr<YosenMappedFileData> mapping);
+
+	YosenObject* clone() override;
+	std::string to_string() override;
+	const char* runtime_name() const override;
+
+private:
+	std::shared_ptr<YosenMappedFileData> m_mapping;
+
+	static YosenObject* length(YosenObject* self, YosenArgs args);
+	static YosenObject* get(YosenObject* self, YosenArgs args);
+
+	// Copies out the given number of bytes starting at the given offset
+	static YosenObject* substr(YosenObject* self, YosenArgs args);
+
+	// Returns the offset of the first occurrence of a string or -1,
+	// an optional second argument specifies where to start searching.
+	static YosenObject* find(YosenObject* self, YosenArgs args);
+
+	// Returns the number of lines in the file
+	static YosenObject* count_lines(YosenObject* self, YosenArgs args);
+
+	static YosenObject* to_str(YosenObject* self, YosenArgs args);
+	static YosenObject* view(YosenObject* self, YosenArgs args);
+
+	static const ys_member_native_table_t s_member_native_functions;
+};
+
+// Opens a file for streaming reads, returns a file reader object.
+// Example: var reader = fs::open_reader("server.log");
+YosenObject* _ys_std_fs_open_reader(YosenArgs args);
+
+// Opens a file for buffered writes, an optional second argument
+// specifies whether to append to the file instead of truncating it.
+// Example: var writer = fs::open_writer("out.txt", true);
+YosenObject* _ys_std_fs_open_writer(YosenArgs args);
+
+// Calls a function with every line of a file and returns the number of lines read,
+// iteration stops early if the function returns false.
+// Example: fs::for_each_line("server.log", "process_line");
+YosenObject* _ys_std_fs_for_each_line(YosenArgs args);
+
+// Maps a file into memory and returns a read-only view of its contents
+// Example: var contents = fs::read_mmap("server.log");
+YosenObject* _ys_std_fs_read_mmap(YosenArgs args);
+
+// Returns the contents of a file as a string
+YosenObject* _ys_std_fs_read_text(YosenArgs args);
+
+// Replaces the contents of a file with the given string, returns true on success
+bool _ys_std_fs_write_text(const char* path, std::string_view text);
+
+// Returns the size of a file in bytes or -1 if it doesn't exist
+int64_t _ys_std_fs_file_size(const char* path);
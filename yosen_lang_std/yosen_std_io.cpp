@@ -1,56 +1,147 @@
 #include "yosen_std_io.h"
 #include <iostream>
+#include <charconv>
+#include <stdio.h>
 
-YosenObject* _ys_std_io_print(YosenObject* args)
+#ifdef _WIN32
+	#include <io.h>
+	#define isatty	_isatty
+	#define fileno	_fileno
+#else
+	#include <unistd.h>
+#endif
+
+// Size of the stdout buffer when the output is redirected to a file or a pipe
+static constexpr size_t s_output_block_size = 1 << 16;
+
+// Text of a single print call, written to stdout in one piece
+static thread_local std::string s_output_buffer;
+
+void _ys_std_io_init_output()
 {
-	YosenObject* obj = nullptr;
-	arg_parse(args, "o", &obj);
+	static bool s_initialized = false;
+	if (s_initialized)
+		return;
+
+	s_initialized = true;
+
+	// Terminals keep the default line buffering, otherwise the output all goes through
+	// stdout's buffer, staying ordered with the interpreter's own output, and gets
+	// written in large blocks instead of a system call per few lines.
+	if (!isatty(fileno(stdout)))
+		setvbuf(stdout, nullptr, _IOFBF, s_output_block_size);
+}
+
+// Appends the string representation of the object without creating temporary strings
+static void append_object(std::string& output, YosenObject* obj)
+{
+	std::string_view contents;
 
-	if (!obj)
+	if (get_string_contents(obj, contents))
 	{
-		// Free the parameter pack
-		free_object(args);
+		output += contents;
+	}
+	else if (obj->is<YosenInteger>())
+	{
+		char digits[24];
+		auto result = std::to_chars(digits, digits + sizeof(digits), obj->as<YosenInteger>()->value);
 
-		auto ex_reason = "print() expects 1 argument";
-		YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
+		output.append(digits, result.ptr);
 	}
+	else
+		output += obj->to_string();
+}
 
-	printf("%s", obj->to_string().c_str());
-	return YosenObject_Null->clone();
+static void write_output(const std::string& output)
+{
+	fwrite(output.data(), 1, output.size(), stdout);
 }
 
-YosenObject* _ys_std_io_println(YosenObject* args)
+YosenObject* _ys_std_io_print(YosenArgs args)
 {
 	YosenObject* obj = nullptr;
-	arg_parse(args, "o", &obj);
+	if (!arg_parse(args, obj))
+		return nullptr;
 
-	if (!obj)
-	{
-		// Free the parameter pack
-		free_object(args);
+	s_output_buffer.clear();
+	append_object(s_output_buffer, obj);
 
-		auto ex_reason = "println() expects 1 argument";
-		YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
-	}
+	write_output(s_output_buffer);
+	return YosenObject_Null;
+}
+
+YosenObject* _ys_std_io_println(YosenArgs args)
+{
+	YosenObject* obj = nullptr;
+	if (!arg_parse(args, obj))
+		return nullptr;
+
+	s_output_buffer.clear();
+	append_object(s_output_buffer, obj);
+	s_output_buffer += '\n';
 
-	printf("%s\n", obj->to_string().c_str());
-	return YosenObject_Null->clone();
+	write_output(s_output_buffer);
+	return YosenObject_Null;
 }
 
-YosenObject* _ys_std_io_input(YosenObject* args)
+YosenObject* _ys_std_io_input(YosenArgs args)
 {
-	if (static_cast<YosenTuple*>(args)->items.size())
+	if (args.size())
 	{
 		YosenObject* obj = nullptr;
-		arg_parse(args, "o", &obj);
+		arg_parse(args, obj);
 
 		printf("%s", obj->to_string().c_str());
 	}
-	else
-		arg_parse(args, "");
+
+	// The prompt and any buffered output have to be visible before reading
+	fflush(stdout);
 
 	std::string input;
 	std::getline(std::cin, input);
 
 	return allocate_object<YosenString>(input);
 }
+
+YosenObject* _ys_std_io_flush(YosenArgs args)
+{
+	fflush(stdout);
+	return YosenObject_Null;
+}
+
+YosenObject* _ys_std_io_write_all(YosenArgs args)
+{
+	YosenObject* obj = nullptr;
+	if (!arg_parse(args, obj))
+		return nullptr;
+
+	std::vector<YosenObject*>* items = nullptr;
+
+	if (obj->is<YosenList>())
+		items = &obj->as<YosenList>()->items;
+	else if (obj->is<YosenTuple>())
+		items = &obj->as<YosenTuple>()->items;
+	else
+	{
+		auto ex_reason = "io::write_all expects a List or a Tuple, not " + std::string(obj->runtime_name());
+		YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
+		return nullptr;
+	}
+
+	// Every item is written on its own line with a single write
+	s_output_buffer.clear();
+
+	for (auto item : *items)
+	{
+		append_object(s_output_buffer, item);
+		s_output_buffer += '\n';
+	}
+
+	write_output(s_output_buffer);
+
+	// Keeps a large list from holding on to its memory
+	if (s_output_buffer.capacity() > s_output_block_size)
+		std::string().swap(s_output_buffer);
+
+	return YosenObject_Null;
+}
@@ -2,8 +2,15 @@
 #include <YosenEnvironment.h>
 using namespace yosen;
 
-YosenObject* _ys_std_io_print(YosenObject* args);
+// Enlarges the stdout buffer when the output isn't a terminal
+void _ys_std_io_init_output();
 
-YosenObject* _ys_std_io_println(YosenObject* args);
+YosenObject* _ys_std_io_print(YosenArgs args);
 
-YosenObject* _ys_std_io_input(YosenObject* args);
+YosenObject* _ys_std_io_println(YosenArgs args);
+
+YosenObject* _ys_std_io_input(YosenArgs args);
+
+YosenObject* _ys_std_io_flush(YosenArgs args);
+
+YosenObject* _ys_std_io_write_all(YosenArgs args);
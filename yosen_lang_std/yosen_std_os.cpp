@@ -9,21 +9,8 @@
 	#define pclose	_pclose
 #endif
 
-YosenObject* _ys_std_os_system(YosenObject* args)
+std::string _ys_std_os_system(const char* cmd)
 {
-    char* cmd = nullptr;
-	arg_parse(args, "s", &cmd);
-
-	if (!cmd)
-	{
-		// Free the parameter pack
-		free_object(args);
-
-		auto ex_reason = "os::system() expected 1 string argument: cmd";
-		YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
-        return nullptr;
-	}
-
     std::array<char, 4096> buffer;
     std::string result;
     std::unique_ptr<FILE, decltype(&pclose)> pipe(popen(cmd, "r"), pclose);
@@ -34,148 +21,50 @@ YosenObject* _ys_std_os_system(YosenObject* args)
         result += buffer.data();
     }
     
-    return allocate_object<YosenString>(result);
+    return result;
 }
 
-YosenObject* _ys_std_os_chdir(YosenObject* args)
+bool _ys_std_os_chdir(const char* path)
 {
-    char* path = nullptr;
-	arg_parse(args, "s", &path);
-
-	if (!path)
-	{
-		// Free the parameter pack
-		free_object(args);
-
-		auto ex_reason = "os::chdir() expected 1 string argument: path";
-		YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
-        return nullptr;
-	}
-
     if (std::filesystem::is_directory(path))
     {
         std::filesystem::current_path(path);
-        return allocate_object<YosenBoolean>(true);
+        return true;
     }
 
-    return allocate_object<YosenBoolean>(false);
+    return false;
 }
 
-YosenObject* _ys_std_os_cwd(YosenObject* args)
+std::string _ys_std_os_cwd()
 {
-    if (static_cast<YosenTuple*>(args)->items.size())
-    {
-        // Free the parameter pack
-		free_object(args);
-
-		auto ex_reason = "os::cwd() expected 0 arguments";
-		YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
-        return nullptr;
-    }
-	arg_parse(args, "");
-
-    return allocate_object<YosenString>(std::filesystem::current_path().string());
+    return std::filesystem::current_path().string();
 }
 
-YosenObject* _ys_std_os_mkdir(YosenObject* args)
+bool _ys_std_os_mkdir(const char* path)
 {
-    char* path = nullptr;
-	arg_parse(args, "s", &path);
-
-	if (!path)
-	{
-		// Free the parameter pack
-		free_object(args);
-
-		auto ex_reason = "os::mkdir() expected 1 string argument: path";
-		YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
-        return nullptr;
-	}
-
     if (std::filesystem::exists(path))
-        return allocate_object<YosenBoolean>(false);
+        return false;
 
-    bool result = std::filesystem::create_directory(path);
-    return allocate_object<YosenBoolean>(result);
+    return std::filesystem::create_directory(path);
 }
 
-YosenObject* _ys_std_os_is_file(YosenObject* args)
+bool _ys_std_os_is_file(const char* path)
 {
-    char* path = nullptr;
-	arg_parse(args, "s", &path);
-
-	if (!path)
-	{
-		// Free the parameter pack
-		free_object(args);
-
-		auto ex_reason = "os::is_file() expected 1 string argument: path";
-		YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
-        return nullptr;
-	}
-
-    bool result = !std::filesystem::is_directory(path);
-    return allocate_object<YosenBoolean>(result);
+    return !std::filesystem::is_directory(path);
 }
 
-YosenObject* _ys_std_os_is_dir(YosenObject* args)
+bool _ys_std_os_is_dir(const char* path)
 {
-    char* path = nullptr;
-	arg_parse(args, "s", &path);
-
-	if (!path)
-	{
-		// Free the parameter pack
-		free_object(args);
-
-		auto ex_reason = "os::is_dir() expected 1 string argument: path";
-		YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
-        return nullptr;
-	}
-
-    bool result = std::filesystem::is_directory(path);
-    return allocate_object<YosenBoolean>(result);
+    return std::filesystem::is_directory(path);
 }
 
-YosenObject* _ys_std_os_delete_file(YosenObject* args)
+bool _ys_std_os_delete_file(const char* path)
 {
-    char* path = nullptr;
-	arg_parse(args, "s", &path);
-
-	if (!path)
-	{
-		// Free the parameter pack
-		free_object(args);
-
-		auto ex_reason = "os::delete_file() expected 1 string argument: path";
-		YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
-        return nullptr;
-	}
-
-    bool result = std::filesystem::remove(path);
-    return allocate_object<YosenBoolean>(result);
+    return std::filesystem::remove(path);
 }
 
-YosenObject* _ys_std_os_delete_dir(YosenObject* args)
+bool _ys_std_os_delete_dir(const char* path)
 {
-    char* path = nullptr;
-	arg_parse(args, "s", &path);
-
-	if (!path)
-	{
-		// Free the parameter pack
-		free_object(args);
-
-		auto ex_reason = "os::delete_file() expected 1 string argument: path";
-		YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
-        return nullptr;
-	}
-
     auto deleted_count = std::filesystem::remove_all(path);
-    
-    if (deleted_count > 0)
-        return allocate_object<YosenBoolean>(true);
-    else
-        return allocate_object<YosenBoolean>(false);
+    return deleted_count > 0;
 }
-
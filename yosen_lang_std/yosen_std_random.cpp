@@ -55,55 +55,32 @@ static std::string generate_hex_string(size_t length)
     return result;
 }
 
-YosenObject* _ys_std_random_gen_int(YosenObject* args)
+int64_t _ys_std_random_gen_int()
 {
-    if (static_cast<YosenTuple*>(args)->items.size())
-    {
-        // Free the parameter pack
-		free_object(args);
-
-		auto ex_reason = "random::gen_int() expected 0 arguments";
-		YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
-        return nullptr;
-    }
-    arg_parse(args, "");
-
     std::random_device os_seed;
     const u32 seed = os_seed();
 
     engine generator(seed);
     std::uniform_int_distribution<u32> distribute(0, std::numeric_limits<u32>::max());
 
-    int64_t result = (int64_t)distribute(generator);
-    return allocate_object<YosenInteger>(result);
+    return (int64_t)distribute(generator);
 }
 
-YosenObject* _ys_std_random_gen_int_range(YosenObject* args)
+int64_t _ys_std_random_gen_int_range(int64_t low, int64_t high)
 {
-    int64_t low = std::numeric_limits<int64_t>::min();
-    int64_t high = std::numeric_limits<int64_t>::min();
-	arg_parse(args, "ii", &low, &high);
-
 	std::random_device os_seed;
     const u32 seed = os_seed();
 
     engine generator(seed);
     std::uniform_int_distribution<u32> distribute(static_cast<u32>(low), static_cast<u32>(high));
 
-    int64_t result = (int64_t)distribute(generator);
-    return allocate_object<YosenInteger>(result);
+    return (int64_t)distribute(generator);
 }
 
-YosenObject* _ys_std_random_gen_string(YosenObject* args)
+YosenObject* _ys_std_random_gen_string(int64_t length)
 {
-    int64_t length = std::numeric_limits<int64_t>::min();
-	arg_parse(args, "i", &length);
-
     if (length <= 0)
     {
-        // Free the parameter pack
-		free_object(args);
-
 		auto ex_reason = "random::gen_str() requires length to be greater than 0";
 		YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
         return nullptr;
@@ -112,16 +89,10 @@ YosenObject* _ys_std_random_gen_string(YosenObject* args)
     return allocate_object<YosenString>(generate_string(length));
 }
 
-YosenObject* _ys_std_random_gen_hex_string(YosenObject* args)
+YosenObject* _ys_std_random_gen_hex_string(int64_t length)
 {
-    int64_t length = std::numeric_limits<int64_t>::min();
-	arg_parse(args, "i", &length);
-
     if (length <= 0)
     {
-        // Free the parameter pack
-		free_object(args);
-
 		auto ex_reason = "random::gen_hex_str() requires length to be greater than 0";
 		YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
         return nullptr;
@@ -130,18 +101,7 @@ YosenObject* _ys_std_random_gen_hex_string(YosenObject* args)
     return allocate_object<YosenString>(generate_hex_string(length));
 }
 
-YosenObject* _ys_std_random_gen_uuid(YosenObject* args)
+std::string _ys_std_random_gen_uuid()
 {
-    if (static_cast<YosenTuple*>(args)->items.size())
-    {
-        // Free the parameter pack
-		free_object(args);
-
-		auto ex_reason = "random::gen_uuid() expected 0 arguments";
-		YosenEnvironment::get().throw_exception(RuntimeException(ex_reason));
-        return nullptr;
-    }
-    arg_parse(args, "");
-    
-    return allocate_object<YosenString>(generate_uuid());
+    return generate_uuid();
 }
@@ -3,17 +3,17 @@
 using namespace yosen;
 
 // Generates and returns a random integer
-YosenObject* _ys_std_random_gen_int(YosenObject* args);
+int64_t _ys_std_random_gen_int();
 
 // Generates and returns a random integer,
 // within range [low, high] inclusive.
-YosenObject* _ys_std_random_gen_int_range(YosenObject* args);
+int64_t _ys_std_random_gen_int_range(int64_t low, int64_t high);
 
 // Generates and returns a random string of given length
-YosenObject* _ys_std_random_gen_string(YosenObject* args);
+YosenObject* _ys_std_random_gen_string(int64_t length);
 
 // Generates and returns a random hex string
-YosenObject* _ys_std_random_gen_hex_string(YosenObject* args);
+YosenObject* _ys_std_random_gen_hex_string(int64_t length);
 
 // Generates and returns a new unique UUID
-YosenObject* _ys_std_random_gen_uuid(YosenObject* args);
+std::string _ys_std_random_gen_uuid();
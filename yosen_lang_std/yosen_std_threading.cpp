@@ -0,0 +1,108 @@
+#include "yosen_std_threading.h"
+
+YosenTaskState::~YosenTaskState()
+{
+	if (result)
+		free_object(result);
+}
+
+const ys_member_native_table_t YosenFuture::s_member_native_functions = {
+	{ "join", join },
+	{ "done", done },
+	{ "error", error },
+};
+
+YosenFuture::YosenFuture(std::shared_ptr<YosenTaskState> state)
+	: m_state(state)
+{
+	m_member_native_table = &s_member_native_functions;
+}
+
+YosenObject* YosenFuture::clone()
+{
+	return allocate_object<YosenFuture>(m_state);
+}
+
+std::string YosenFuture::to_string()
+{
+	return "Future " + instance_info();
+}
+
+const char* YosenFuture::runtime_name() const
+{
+	return "Future";
+}
+
+YosenObject* YosenFuture::join(YosenObject* self, YosenArgs args)
+{
+	auto& state = static_cast<YosenFuture*>(self)->m_state;
+	YosenTaskPool::get().wait(state->latch);
+
+	if (state->exception)
+	{
+		YosenEnvironment::get().throw_exception(*state->exception);
+		return nullptr;
+	}
+
+	return state->result->clone();
+}
+
+YosenObject* YosenFuture::done(YosenObject* self, YosenArgs args)
+{
+	auto& state = static_cast<YosenFuture*>(self)->m_state;
+	return get_boolean_object(state->latch.is_done());
+}
+
+YosenObject* YosenFuture::error(YosenObject* self, YosenArgs args)
+{
+	auto& state = static_cast<YosenFuture*>(self)->m_state;
+	YosenTaskPool::get().wait(state->latch);
+
+	if (!state->exception)
+		return YosenObject_Null;
+
+	return allocate_object<YosenString>(state->exception->to_string());
+}
+
+YosenObject* _ys_std_threading_submit(YosenArgs args)
+{
+	std::string fn_name;
+	if (!arg_parse(args, fn_name))
+		return nullptr;
+
+	auto& env = YosenEnvironment::get();
+
+	// The task works with its own copies of the arguments
+	std::vector<YosenObject*> fn_args;
+	for (size_t i = 1; i < args.size(); ++i)
+		fn_args.push_back(args[i]->clone());
+
+	auto state = std::make_shared<YosenTaskState>();
+
+	YosenTaskPool::get().submit([&env, state, fn_name, fn_args]() {
+		auto context = env.create_execution_context();
+
+		// Exceptions are kept in the state instead of being thrown on the worker thread
+		if (!context)
+			state->exception = RuntimeException("No interpreter is available to run \"" + fn_name + "\"");
+		else
+		{
+			state->result = context->call_function(fn_name, YosenArgs(fn_args.data(), fn_args.size()));
+
+			if (!state->result)
+				state->exception = *context->get_last_exception();
+		}
+
+		for (auto& arg : fn_args)
+			free_object(arg);
+
+		state->latch.count_down();
+	});
+
+	return allocate_object<YosenFuture>(state);
+}
+
+int64_t _ys_std_threading_worker_count()
+{
+	return static_cast<int64_t>(YosenTaskPool::get().worker_count());
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <YosenEnvironment.h>
+#include <optional>
+using namespace yosen;
+
+// State shared between a submitted task and its futures
+struct YosenTaskState
+{
+	YosenTaskLatch latch = YosenTaskLatch(1);
+
+	// Object returned by the task, owned by the state
+	YosenObject* result = nullptr;
+
+	// Exception that stopped the task, raised again by the thread that joins it
+	std::optional<YosenException> exception;
+
+	~YosenTaskState();
+};
+
+// Handle to the result of a task running on the task pool
+class YosenFuture : public YosenObject
+{
+public:
+	YosenFuture(std::shared_ptr<YosenTaskState> state);
+
+	YosenObject* clone() override;
+	std::string to_string() override;
+	const char* runtime_name() const override;
+
+private:
+	std::shared_ptr<YosenTaskState> m_state;
+
+	// Waits for the task to complete and returns a copy of its result,
+	// or throws the task's exception on the calling thread if it failed.
+	static YosenObject* join(YosenObject* self, YosenArgs args);
+
+	// Returns whether or not the task has completed
+	static YosenObject* done(YosenObject* self, YosenArgs args);
+
+	// Waits for the task to complete and returns the description of the
+	// exception that stopped it, or null if the task completed successfully.
+	static YosenObject* error(YosenObject* self, YosenArgs args);
+
+	static const ys_member_native_table_t s_member_native_functions;
+};
+
+// Submits a function to be called on the task pool with
+// copies of the given arguments, returns a future object.
+// Example: var f = threading::submit("work", item);
+YosenObject* _ys_std_threading_submit(YosenArgs args);
+
+// Returns the number of worker threads in the task pool
+int64_t _ys_std_threading_worker_count();